@@ -3,6 +3,8 @@
 
 #include "plugin-support.h"
 #include "zoominator-controller.hpp"
+#include "zoominator-camera-filter.hpp"
+#include "zoominator-marker-source.hpp"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
@@ -16,6 +18,8 @@ bool obs_module_load(void)
 {
 	obs_log(LOG_INFO, "[Zoominator] loaded (version %s)", PLUGIN_VERSION);
 
+	zoominator_camera_filter_register();
+	zoominator_marker_source_register();
 	ZoominatorController::instance().initialize();
 
 	obs_frontend_add_tools_menu_item("Zoominator ...", open_dialog_cb, nullptr);
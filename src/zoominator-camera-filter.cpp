@@ -0,0 +1,104 @@
+#include "zoominator-camera-filter.hpp"
+#include "zoominator-camera.hpp"
+
+#include <graphics/matrix4.h>
+
+#include <cstring>
+#include <mutex>
+
+struct ZoominatorCameraFilter {
+	obs_source_t *context = nullptr;
+	std::mutex lock;
+	float scale = 1.0f;
+	float translateX = 0.0f;
+	float translateY = 0.0f;
+};
+
+static const char *camera_filter_get_name(void *)
+{
+	return kZoominatorCameraFilterName;
+}
+
+static void *camera_filter_create(obs_data_t *, obs_source_t *source)
+{
+	auto *filter = new ZoominatorCameraFilter();
+	filter->context = source;
+	return filter;
+}
+
+static void camera_filter_destroy(void *data)
+{
+	delete static_cast<ZoominatorCameraFilter *>(data);
+}
+
+static void camera_filter_video_render(void *data, gs_effect_t *)
+{
+	auto *filter = static_cast<ZoominatorCameraFilter *>(data);
+	if (!filter)
+		return;
+
+	float scale = 1.0f;
+	float translateX = 0.0f;
+	float translateY = 0.0f;
+	{
+		std::lock_guard<std::mutex> guard(filter->lock);
+		scale = filter->scale;
+		translateX = filter->translateX;
+		translateY = filter->translateY;
+	}
+
+	obs_source_t *target = obs_filter_get_target(filter->context);
+	const uint32_t width = target ? obs_source_get_base_width(target) : 0;
+	const uint32_t height = target ? obs_source_get_base_height(target) : 0;
+	const bool identity = scale == 1.0f && translateX == 0.0f && translateY == 0.0f;
+	if (identity || width == 0 || height == 0) {
+		obs_source_skip_video_filter(filter->context);
+		return;
+	}
+
+	if (!obs_source_process_filter_begin(filter->context, GS_RGBA, OBS_ALLOW_DIRECT_RENDERING))
+		return;
+
+	const ZoominatorMatrix4 camera = zoominator_camera_filter_matrix(scale, translateX, translateY);
+	struct matrix4 m;
+	vec4_set(&m.x, camera.rows[0][0], camera.rows[0][1], camera.rows[0][2], camera.rows[0][3]);
+	vec4_set(&m.y, camera.rows[1][0], camera.rows[1][1], camera.rows[1][2], camera.rows[1][3]);
+	vec4_set(&m.z, camera.rows[2][0], camera.rows[2][1], camera.rows[2][2], camera.rows[2][3]);
+	vec4_set(&m.t, camera.rows[3][0], camera.rows[3][1], camera.rows[3][2], camera.rows[3][3]);
+
+	gs_matrix_push();
+	gs_matrix_mul(&m);
+	obs_source_process_filter_end(filter->context, obs_get_base_effect(OBS_EFFECT_DEFAULT), width, height);
+	gs_matrix_pop();
+}
+
+void zoominator_camera_filter_register()
+{
+	obs_source_info info{};
+	info.id = kZoominatorCameraFilterId;
+	info.type = OBS_SOURCE_TYPE_FILTER;
+	info.output_flags = OBS_SOURCE_VIDEO;
+	info.get_name = camera_filter_get_name;
+	info.create = camera_filter_create;
+	info.destroy = camera_filter_destroy;
+	info.video_render = camera_filter_video_render;
+	obs_register_source(&info);
+}
+
+void zoominator_camera_filter_set_camera(obs_source_t *filter, float scale, float translateX, float translateY)
+{
+	if (!filter)
+		return;
+	const char *id = obs_source_get_unversioned_id(filter);
+	if (!id || strcmp(id, kZoominatorCameraFilterId) != 0)
+		return;
+
+	auto *data = static_cast<ZoominatorCameraFilter *>(obs_obj_get_data(filter));
+	if (!data)
+		return;
+
+	std::lock_guard<std::mutex> guard(data->lock);
+	data->scale = scale;
+	data->translateX = translateX;
+	data->translateY = translateY;
+}
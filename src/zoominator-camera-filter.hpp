@@ -0,0 +1,14 @@
+#pragma once
+
+#include <obs-module.h>
+
+static constexpr const char *kZoominatorCameraFilterId = "zoominator_camera";
+static constexpr const char *kZoominatorCameraFilterName = "Zoominator Camera";
+
+// Video filter that renders its parent (normally the current scene) through a
+// uniform scale followed by a translation, in canvas pixels:
+//   out = in * scale + (translateX, translateY)
+// The controller feeds it the same camera that item mode writes to each scene
+// item, so zooming never touches item transforms or the recovery map.
+void zoominator_camera_filter_register();
+void zoominator_camera_filter_set_camera(obs_source_t *filter, float scale, float translateX, float translateY);
@@ -0,0 +1,161 @@
+#include "zoominator-camera.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define ZOOMINATOR_CAMERA_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#	include <arm_neon.h>
+#	define ZOOMINATOR_CAMERA_NEON 1
+#endif
+
+void ZoominatorItemBatch::clear()
+{
+	posX.clear();
+	posY.clear();
+	scaleX.clear();
+	scaleY.clear();
+	outPosX.clear();
+	outPosY.clear();
+	outScaleX.clear();
+	outScaleY.clear();
+}
+
+void ZoominatorItemBatch::push(float x, float y, float sx, float sy)
+{
+	posX.push_back(x);
+	posY.push_back(y);
+	scaleX.push_back(sx);
+	scaleY.push_back(sy);
+}
+
+double zoominator_camera_smoothstep(double t)
+{
+	t = std::clamp(t, 0.0, 1.0);
+	return t * t * (3.0 - 2.0 * t);
+}
+
+double zoominator_camera_zoom_at(double t, double zoomFactor)
+{
+	const double target = (zoomFactor <= 1.0) ? 1.0 : zoomFactor;
+	return 1.0 + (target - 1.0) * zoominator_camera_smoothstep(t);
+}
+
+ZoominatorEffectiveTransform zoominator_camera_effective_transform(const ZoominatorItemGeometry &g)
+{
+	ZoominatorEffectiveTransform out;
+	const float visibleW = g.visibleW > 0.0f ? g.visibleW : 1.0f;
+	const float visibleH = g.visibleH > 0.0f ? g.visibleH : 1.0f;
+
+	if (!g.useBounds || g.boundsW <= 0.0f || g.boundsH <= 0.0f) {
+		out.width = visibleW * g.scaleX;
+		out.height = visibleH * g.scaleY;
+	} else {
+		out.width = g.boundsW;
+		out.height = g.boundsH;
+	}
+	out.scaleX = out.width / visibleW;
+	out.scaleY = out.height / visibleH;
+
+	out.posX = g.posX;
+	if (g.alignX > 0)
+		out.posX -= out.width;
+	else if (g.alignX == 0)
+		out.posX -= out.width * 0.5f;
+
+	out.posY = g.posY;
+	if (g.alignY > 0)
+		out.posY -= out.height;
+	else if (g.alignY == 0)
+		out.posY -= out.height * 0.5f;
+
+	return out;
+}
+
+static double clamp_axis_offset(double minOffset, double maxOffset)
+{
+	// Prefer no offset; if the zoomed content is smaller than the canvas on
+	// this axis, center it instead.
+	if (minOffset <= maxOffset)
+		return std::clamp(0.0, minOffset, maxOffset);
+	return (minOffset + maxOffset) * 0.5;
+}
+
+void zoominator_camera_clamp_offset(ZoominatorCamera &camera, const ZoominatorBounds &content, double canvasW,
+				    double canvasH)
+{
+	camera.offsetX = 0.0;
+	camera.offsetY = 0.0;
+
+	const double refMinX = camera.mapX(content.minX);
+	const double refMaxX = camera.mapX(content.maxX);
+	const double refMinY = camera.mapY(content.minY);
+	const double refMaxY = camera.mapY(content.maxY);
+
+	camera.offsetX = clamp_axis_offset(canvasW - refMaxX, -refMinX);
+	camera.offsetY = clamp_axis_offset(canvasH - refMaxY, -refMinY);
+}
+
+void zoominator_camera_transform_items(const ZoominatorCamera &camera, ZoominatorItemBatch &batch)
+{
+	const size_t n = batch.size();
+	batch.outPosX.resize(n);
+	batch.outPosY.resize(n);
+	batch.outScaleX.resize(n);
+	batch.outScaleY.resize(n);
+
+	const float z = (float)camera.zoom;
+	const float tx = (float)camera.translateX();
+	const float ty = (float)camera.translateY();
+
+	const float *px = batch.posX.data();
+	const float *py = batch.posY.data();
+	const float *sx = batch.scaleX.data();
+	const float *sy = batch.scaleY.data();
+	float *opx = batch.outPosX.data();
+	float *opy = batch.outPosY.data();
+	float *osx = batch.outScaleX.data();
+	float *osy = batch.outScaleY.data();
+
+	size_t i = 0;
+#if defined(ZOOMINATOR_CAMERA_SSE2)
+	const __m128 vz = _mm_set1_ps(z);
+	const __m128 vtx = _mm_set1_ps(tx);
+	const __m128 vty = _mm_set1_ps(ty);
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(opx + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(px + i), vz), vtx));
+		_mm_storeu_ps(opy + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(py + i), vz), vty));
+		_mm_storeu_ps(osx + i, _mm_mul_ps(_mm_loadu_ps(sx + i), vz));
+		_mm_storeu_ps(osy + i, _mm_mul_ps(_mm_loadu_ps(sy + i), vz));
+	}
+#elif defined(ZOOMINATOR_CAMERA_NEON)
+	const float32x4_t vz = vdupq_n_f32(z);
+	const float32x4_t vtx = vdupq_n_f32(tx);
+	const float32x4_t vty = vdupq_n_f32(ty);
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(opx + i, vmlaq_f32(vtx, vld1q_f32(px + i), vz));
+		vst1q_f32(opy + i, vmlaq_f32(vty, vld1q_f32(py + i), vz));
+		vst1q_f32(osx + i, vmulq_f32(vld1q_f32(sx + i), vz));
+		vst1q_f32(osy + i, vmulq_f32(vld1q_f32(sy + i), vz));
+	}
+#endif
+	for (; i < n; i++) {
+		opx[i] = px[i] * z + tx;
+		opy[i] = py[i] * z + ty;
+		osx[i] = sx[i] * z;
+		osy[i] = sy[i] * z;
+	}
+}
+
+ZoominatorMatrix4 zoominator_camera_filter_matrix(float scale, float translateX, float translateY)
+{
+	ZoominatorMatrix4 m;
+	m.rows[0][0] = scale;
+	m.rows[1][1] = scale;
+	m.rows[2][2] = 1.0f;
+	m.rows[3][0] = translateX;
+	m.rows[3][1] = translateY;
+	m.rows[3][3] = 1.0f;
+	return m;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Camera math shared by every zoom method. Deliberately free of Qt and libobs
+// so it can be built and profiled on its own.
+//
+// A camera maps a scene point p to the display as
+//   display = anchor + (p - focus) * zoom + offset
+// which is applied to items as a uniform scale plus a translation.
+
+struct ZoominatorCamera {
+	double zoom = 1.0;
+	double anchorX = 0.0;
+	double anchorY = 0.0;
+	double focusX = 0.0;
+	double focusY = 0.0;
+	double offsetX = 0.0;
+	double offsetY = 0.0;
+
+	double translateX() const { return anchorX - focusX * zoom + offsetX; }
+	double translateY() const { return anchorY - focusY * zoom + offsetY; }
+	double mapX(double x) const { return anchorX + (x - focusX) * zoom + offsetX; }
+	double mapY(double y) const { return anchorY + (y - focusY) * zoom + offsetY; }
+};
+
+struct ZoominatorBounds {
+	double minX = 0.0;
+	double minY = 0.0;
+	double maxX = 0.0;
+	double maxY = 0.0;
+};
+
+// Axis-aligned layout of one scene item before zooming. Alignment is -1 for
+// left/top, 0 for center and +1 for right/bottom.
+struct ZoominatorItemGeometry {
+	float posX = 0.0f;
+	float posY = 0.0f;
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	float visibleW = 1.0f;
+	float visibleH = 1.0f;
+	bool useBounds = false;
+	float boundsW = 0.0f;
+	float boundsH = 0.0f;
+	int alignX = -1;
+	int alignY = -1;
+};
+
+// Top-left position and scale that reproduce the item's rendered rectangle
+// with top-left alignment and no bounds.
+struct ZoominatorEffectiveTransform {
+	float posX = 0.0f;
+	float posY = 0.0f;
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	float width = 0.0f;
+	float height = 0.0f;
+};
+
+// Structure-of-arrays batch: inputs are the effective transforms captured at
+// zoom start, outputs are filled by zoominator_camera_transform_items().
+struct ZoominatorItemBatch {
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> scaleX;
+	std::vector<float> scaleY;
+	std::vector<float> outPosX;
+	std::vector<float> outPosY;
+	std::vector<float> outScaleX;
+	std::vector<float> outScaleY;
+
+	size_t size() const { return posX.size(); }
+	void clear();
+	void push(float x, float y, float sx, float sy);
+};
+
+// Affine transform in the layout of libobs' struct matrix4: rows x, y, z and
+// t, applied to row vectors, so a point maps as (px, py, 0, 1) * M and the
+// translation sits in row t.
+struct ZoominatorMatrix4 {
+	float rows[4][4]{};
+};
+
+double zoominator_camera_smoothstep(double t);
+double zoominator_camera_zoom_at(double t, double zoomFactor);
+ZoominatorEffectiveTransform zoominator_camera_effective_transform(const ZoominatorItemGeometry &geometry);
+void zoominator_camera_clamp_offset(ZoominatorCamera &camera, const ZoominatorBounds &content, double canvasW,
+				    double canvasH);
+void zoominator_camera_transform_items(const ZoominatorCamera &camera, ZoominatorItemBatch &batch);
+// Matrix the camera filter multiplies onto the render stack: scale about the
+// canvas origin, then translate, i.e. out = in * scale + translate.
+ZoominatorMatrix4 zoominator_camera_filter_matrix(float scale, float translateX, float translateY);
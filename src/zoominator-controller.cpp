@@ -1,4 +1,8 @@
 #include "zoominator-controller.hpp"
+#include "zoominator-camera-filter.hpp"
+#include "zoominator-marker-source.hpp"
+#include "zoominator-recovery-journal.hpp"
+#include "zoominator-trigger.hpp"
 
 #include <obs-frontend-api.h>
 #include <obs.h>
@@ -12,15 +16,14 @@
 #include <QKeyCombination>
 #include <QRegularExpression>
 #include <QDateTime>
-#include <QColor>
-#include <QImage>
-#include <QPainter>
-#include <QPen>
+#include <QStringList>
+#include <QThread>
 
 #include <cmath>
 #include <algorithm>
+#include <climits>
+#include <cstring>
 
-#include <QFileInfo>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -44,6 +47,11 @@
 #include <X11/extensions/Xrandr.h>
 #include <X11/Xatom.h>
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+
 #undef Bool
 #undef None
 #undef Status
@@ -57,15 +65,35 @@
 #undef Unsorted
 
 static constexpr long X11_None = 0L;
+
+// Long-lived connection for synchronous queries (XRandR, window lookup). The
+// input thread reads XInput2 events on its own connection (xiDisplay), so these
+// round trips never consume or reorder its events. UI thread only.
+static Display *g_x11QueryDisplay = nullptr;
+
+static Display *shared_x11_display()
+{
+	if (!g_x11QueryDisplay)
+		g_x11QueryDisplay = XOpenDisplay(nullptr);
+	return g_x11QueryDisplay;
+}
+
+static void close_shared_x11_display()
+{
+	if (g_x11QueryDisplay) {
+		XCloseDisplay(g_x11QueryDisplay);
+		g_x11QueryDisplay = nullptr;
+	}
+}
 #endif
 
 static int qtKeyToVk(int qtKey);
 
-static constexpr const char *kZoominatorMarkerSourceName = "Zoominator Cursor Marker";
-static constexpr const char *kZoominatorMarkerSourceId = "zoominator_marker_source";
+static constexpr const char *kZoominatorContainerName = "Zoominator Camera";
+static constexpr qsizetype kMaxRecoveryStates = 4096;
 static void cleanup_legacy_marker_items_all_scenes(obs_source_t *currentMarkerSource = nullptr);
+static void remove_stale_camera_filters(obs_source_t *activeFilter);
 static bool source_name_starts_with(const char *name, const char *prefix);
-static void collect_live_scene_items(obs_scene_t *scene, std::vector<obs_sceneitem_t *> &items);
 
 static inline double clampd(double v, double lo, double hi)
 {
@@ -76,21 +104,6 @@ static inline double clampd(double v, double lo, double hi)
 	return v;
 }
 
-static inline double smoothstep(double t)
-{
-	return t * t * (3.0 - 2.0 * t);
-}
-
-static inline bool nearly_equal(float a, float b, float eps = 0.5f)
-{
-	return std::fabs(a - b) <= eps;
-}
-
-static inline bool nearly_equal_vec2(const vec2 &a, const vec2 &b, float eps = 0.01f)
-{
-	return nearly_equal(a.x, b.x, eps) && nearly_equal(a.y, b.y, eps);
-}
-
 static inline void logi(bool enabled, const char *fmt, ...)
 {
 	if (!enabled)
@@ -106,46 +119,7 @@ static bool source_name_starts_with(const char *name, const char *prefix)
 {
 	if (!name || !prefix || !*prefix)
 		return false;
-	return QString::fromUtf8(name).startsWith(QString::fromUtf8(prefix));
-}
-
-static void collect_live_scene_items(obs_scene_t *scene, std::vector<obs_sceneitem_t *> &items)
-{
-	if (!scene)
-		return;
-
-	struct Ctx {
-		std::vector<obs_sceneitem_t *> *items = nullptr;
-
-		static bool enum_cb(obs_scene_t *, obs_sceneitem_t *item, void *param)
-		{
-			auto *ctx = static_cast<Ctx *>(param);
-			if (!ctx || !ctx->items || !item)
-				return true;
-
-			ctx->items->push_back(item);
-
-			obs_source_t *src = obs_sceneitem_get_source(item);
-			obs_scene_t *subScene = src ? obs_scene_from_source(src) : nullptr;
-			if (subScene)
-				collect_live_scene_items(subScene, *ctx->items);
-
-			return true;
-		}
-	};
-
-	Ctx ctx{&items};
-	obs_scene_enum_items(scene, Ctx::enum_cb, &ctx);
-}
-
-static bool scene_item_pointer_is_live(obs_scene_t *scene, obs_sceneitem_t *item)
-{
-	if (!scene || !item)
-		return false;
-
-	std::vector<obs_sceneitem_t *> liveItems;
-	collect_live_scene_items(scene, liveItems);
-	return std::find(liveItems.begin(), liveItems.end(), item) != liveItems.end();
+	return strncmp(name, prefix, strlen(prefix)) == 0;
 }
 
 ZoominatorController &ZoominatorController::instance()
@@ -158,6 +132,7 @@ ZoominatorController::ZoominatorController()
 {
 	tickTimer.setInterval(33);
 	connect(&tickTimer, &QTimer::timeout, this, &ZoominatorController::onTick);
+	sceneMirror.setChangedCallback(sceneMirrorChanged, this);
 }
 
 ZoominatorController::~ZoominatorController()
@@ -175,9 +150,9 @@ QString ZoominatorController::configPath() const
 	return p;
 }
 
-QString ZoominatorController::markerImagePath() const
+QString ZoominatorController::recoveryFlagPath() const
 {
-	char *path = obs_module_config_path("zoominator-cursor-marker.png");
+	char *path = obs_module_config_path("zoominator-recovery.flag");
 	if (!path)
 		return {};
 	QString p = QString::fromUtf8(path);
@@ -185,26 +160,55 @@ QString ZoominatorController::markerImagePath() const
 	return p;
 }
 
-QString ZoominatorController::sceneItemKey(obs_sceneitem_t *item) const
+QString ZoominatorController::recoveryJournalPath() const
 {
-	if (!item)
+	char *path = obs_module_config_path("zoominator-recovery.journal");
+	if (!path)
 		return {};
+	QString p = QString::fromUtf8(path);
+	bfree(path);
+	return p;
+}
+
+static bool parse_uuid(const char *text, uint8_t out[16])
+{
+	if (!text)
+		return false;
+
+	int n = 0;
+	for (const char *p = text; *p && n < 32; p++) {
+		if (*p == '-')
+			continue;
+		int v = -1;
+		if (*p >= '0' && *p <= '9')
+			v = *p - '0';
+		else if (*p >= 'a' && *p <= 'f')
+			v = *p - 'a' + 10;
+		else if (*p >= 'A' && *p <= 'F')
+			v = *p - 'A' + 10;
+		if (v < 0)
+			return false;
+		out[n / 2] = (uint8_t)((n & 1) ? (out[n / 2] | v) : (v << 4));
+		n++;
+	}
+	return n == 32;
+}
+
+bool ZoominatorController::sceneItemKey(obs_sceneitem_t *item, SceneItemKey &key) const
+{
+	if (!item)
+		return false;
 
 	obs_source_t *src = obs_sceneitem_get_source(item);
 	obs_scene_t *scene = obs_sceneitem_get_scene(item);
 	obs_source_t *sceneSource = scene ? obs_scene_get_source(scene) : nullptr;
+	if (!src || !sceneSource)
+		return false;
 
-	const char *sceneName = sceneSource ? obs_source_get_name(sceneSource) : nullptr;
-	const char *sourceName = src ? obs_source_get_name(src) : nullptr;
-	const int64_t itemId = obs_sceneitem_get_id(item);
-
-	if (!sceneName || !*sceneName || !sourceName || !*sourceName)
-		return {};
-
-	return QStringLiteral("%1::%2::%3")
-		.arg(QString::fromUtf8(sceneName))
-		.arg(QString::fromUtf8(sourceName))
-		.arg(itemId);
+	key = SceneItemKey{};
+	key.itemId = obs_sceneitem_get_id(item);
+	return parse_uuid(obs_source_get_uuid(sceneSource), key.scene) &&
+	       parse_uuid(obs_source_get_uuid(src), key.source);
 }
 
 ZoominatorController::OrigState ZoominatorController::readSceneItemTransform(obs_sceneitem_t *item) const
@@ -230,19 +234,84 @@ void ZoominatorController::applySceneItemTransform(obs_sceneitem_t *item, const
 	if (!item || !state.valid)
 		return;
 
-	obs_sceneitem_set_pos(item, &state.pos);
-	obs_sceneitem_set_scale(item, &state.scale);
-	obs_sceneitem_set_rot(item, state.rot);
-	obs_sceneitem_set_alignment(item, state.align);
-	obs_sceneitem_set_bounds_type(item, state.boundsType);
-	obs_sceneitem_set_bounds_alignment(item, state.boundsAlign);
-	obs_sceneitem_set_bounds(item, &state.bounds);
-	obs_sceneitem_set_crop(item, &state.crop);
+	TransformOp op;
+	op.item = item;
+	op.restore = &state;
+	queueTransform(op);
+	commitTransformPlan();
+}
+
+void ZoominatorController::queueTransform(TransformOp op)
+{
+	if (!op.item)
+		return;
+	op.parent = obs_sceneitem_get_scene(op.item);
+	if (!op.parent)
+		return;
+	if (std::find(transformPlanScenes.begin(), transformPlanScenes.end(), op.parent) == transformPlanScenes.end())
+		transformPlanScenes.push_back(op.parent);
+	transformPlan.push_back(op);
+}
+
+void ZoominatorController::applyTransformOp(const TransformOp &op)
+{
+	obs_sceneitem_defer_update_begin(op.item);
+	if (op.restore) {
+		const OrigState &state = *op.restore;
+		obs_sceneitem_set_pos(op.item, &state.pos);
+		obs_sceneitem_set_scale(op.item, &state.scale);
+		obs_sceneitem_set_rot(op.item, state.rot);
+		obs_sceneitem_set_alignment(op.item, state.align);
+		obs_sceneitem_set_bounds_type(op.item, state.boundsType);
+		obs_sceneitem_set_bounds_alignment(op.item, state.boundsAlign);
+		obs_sceneitem_set_bounds(op.item, &state.bounds);
+		obs_sceneitem_set_crop(op.item, &state.crop);
+		if (state.hiddenByZoom)
+			obs_sceneitem_set_visible(op.item, true);
+	} else {
+		if (op.clearBounds)
+			obs_sceneitem_set_bounds_type(op.item, OBS_BOUNDS_NONE);
+		if (op.alignTopLeft)
+			obs_sceneitem_set_alignment(op.item, OBS_ALIGN_LEFT | OBS_ALIGN_TOP);
+		if (op.setScale)
+			obs_sceneitem_set_scale(op.item, &op.scale);
+		if (op.setPos)
+			obs_sceneitem_set_pos(op.item, &op.pos);
+	}
+	obs_sceneitem_defer_update_end(op.item);
+}
+
+void ZoominatorController::commitTransformPlan()
+{
+	// Every queued write for a scene lands under a single scene lock, so the
+	// renderer never sees a frame where only part of the plan was applied.
+	struct Batch {
+		const std::vector<TransformOp> *plan = nullptr;
+		obs_scene_t *scene = nullptr;
+	};
+
+	for (obs_scene_t *scene : transformPlanScenes) {
+		Batch batch{&transformPlan, scene};
+		obs_scene_atomic_update(
+			scene,
+			[](void *param, obs_scene_t *) {
+				auto *batch = static_cast<Batch *>(param);
+				for (const TransformOp &op : *batch->plan) {
+					if (op.parent == batch->scene)
+						applyTransformOp(op);
+				}
+			},
+			&batch);
+	}
+
+	transformPlan.clear();
+	transformPlanScenes.clear();
 }
 
 void ZoominatorController::loadRecoveryMap(obs_data_t *data)
 {
-	recoveryTransforms.clear();
+	legacyRecoveryTransforms.clear();
+	recoveryIndexDirty = true;
 	if (!data)
 		return;
 
@@ -273,8 +342,9 @@ void ZoominatorController::loadRecoveryMap(obs_data_t *data)
 			state.crop.top = (int)obs_data_get_int(row, "crop_top");
 			state.crop.right = (int)obs_data_get_int(row, "crop_right");
 			state.crop.bottom = (int)obs_data_get_int(row, "crop_bottom");
+			state.hiddenByZoom = obs_data_get_bool(row, "hidden_by_zoom");
 			state.valid = true;
-			recoveryTransforms.insert(QString::fromUtf8(rawKey), state);
+			legacyRecoveryTransforms.insert(QString::fromUtf8(rawKey), state);
 		}
 
 		obs_data_release(row);
@@ -283,39 +353,258 @@ void ZoominatorController::loadRecoveryMap(obs_data_t *data)
 	obs_data_array_release(arr);
 }
 
-void ZoominatorController::saveRecoveryMap(obs_data_t *data)
+static bool read_binary_file(const QString &path, std::string &out)
 {
-	if (!data)
-		return;
+	out.clear();
+	FILE *f = os_fopen(path.toUtf8().constData(), "rb");
+	if (!f)
+		return false;
+
+	char buf[4096];
+	size_t n = 0;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		out.append(buf, n);
+	fclose(f);
+	return true;
+}
+
+bool ZoominatorController::loadRecoveryJournal()
+{
+	const QString p = recoveryJournalPath();
+	std::string bytes;
+	std::vector<ZoominatorJournalRecord> records;
+	if (p.isEmpty() || !read_binary_file(p, bytes) || !zoominator_journal_decode(bytes, records))
+		return false;
+
+	// The journal is truncated whenever recovery completes, so the first record
+	// for an item predates every unrestored zoom and holds its real original.
+	// Later records only add the hidden flag or move it to a newer activation.
+	auto replay = [](auto &map, const auto &key, const OrigState &state) {
+		auto it = map.find(key);
+		if (it != map.end()) {
+			it->hiddenByZoom = it->hiddenByZoom || state.hiddenByZoom;
+			it->generation = std::max(it->generation, state.generation);
+		} else {
+			map.insert(key, state);
+		}
+	};
 
-	obs_data_array_t *arr = obs_data_array_create();
-	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it) {
-		const OrigState &state = it.value();
-		if (!state.valid)
+	recoveryTransforms.clear();
+	legacyRecoveryTransforms.clear();
+	recoveryActivationStates = 0;
+	recoveryIndexDirty = true;
+	for (const ZoominatorJournalRecord &r : records) {
+		const OrigState state = stateFromJournalRecord(r);
+		if (!r.legacyKey.empty()) {
+			replay(legacyRecoveryTransforms, QString::fromStdString(r.legacyKey), state);
 			continue;
+		}
 
-		obs_data_t *row = obs_data_create();
-		obs_data_set_string(row, "key", it.key().toUtf8().constData());
-		obs_data_set_double(row, "pos_x", state.pos.x);
-		obs_data_set_double(row, "pos_y", state.pos.y);
-		obs_data_set_double(row, "scale_x", state.scale.x);
-		obs_data_set_double(row, "scale_y", state.scale.y);
-		obs_data_set_double(row, "rot", state.rot);
-		obs_data_set_int(row, "align", (long long)state.align);
-		obs_data_set_int(row, "bounds_type", (long long)state.boundsType);
-		obs_data_set_int(row, "bounds_align", (long long)state.boundsAlign);
-		obs_data_set_double(row, "bounds_x", state.bounds.x);
-		obs_data_set_double(row, "bounds_y", state.bounds.y);
-		obs_data_set_int(row, "crop_left", state.crop.left);
-		obs_data_set_int(row, "crop_top", state.crop.top);
-		obs_data_set_int(row, "crop_right", state.crop.right);
-		obs_data_set_int(row, "crop_bottom", state.crop.bottom);
-		obs_data_array_push_back(arr, row);
-		obs_data_release(row);
+		SceneItemKey key;
+		memcpy(key.scene, r.sceneUuid, sizeof(key.scene));
+		memcpy(key.source, r.sourceUuid, sizeof(key.source));
+		key.itemId = r.itemId;
+		replay(recoveryTransforms, key, state);
 	}
+	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it)
+		recoveryActivationStates += it->generation == recoveryActivation ? 1 : 0;
 
-	obs_data_set_array(data, "recovery_transforms", arr);
-	obs_data_array_release(arr);
+	logi(debug, "[Zoominator] Replayed %d recovery record(s) for %d item(s).", (int)records.size(),
+	     (int)(recoveryTransforms.size() + legacyRecoveryTransforms.size()));
+	return true;
+}
+
+ZoominatorController::OrigState ZoominatorController::stateFromJournalRecord(const ZoominatorJournalRecord &r)
+{
+	OrigState state{};
+	state.pos.x = r.posX;
+	state.pos.y = r.posY;
+	state.scale.x = r.scaleX;
+	state.scale.y = r.scaleY;
+	state.rot = r.rot;
+	state.align = r.align;
+	state.boundsType = (obs_bounds_type)r.boundsType;
+	state.boundsAlign = r.boundsAlign;
+	state.bounds.x = r.boundsX;
+	state.bounds.y = r.boundsY;
+	state.crop.left = r.cropLeft;
+	state.crop.top = r.cropTop;
+	state.crop.right = r.cropRight;
+	state.crop.bottom = r.cropBottom;
+	state.hiddenByZoom = r.hiddenByZoom;
+	state.generation = r.activation;
+	state.valid = true;
+	return state;
+}
+
+void ZoominatorController::rememberRecoveryState(const SceneItemKey &key, const OrigState &state)
+{
+	if (!state.valid)
+		return;
+
+	// The first capture of an item is its real original; later captures only
+	// add the hidden flag a zoom container sets. The entry moves to the
+	// current activation either way, since this zoom-out will put it back.
+	// Replay keeps the first record's transform but takes the newest
+	// generation and hidden flag, so either change is journaled.
+	auto it = recoveryTransforms.find(key);
+	if (it != recoveryTransforms.end()) {
+		const bool retag = it->generation != recoveryActivation;
+		const bool hide = state.hiddenByZoom && !it->hiddenByZoom;
+		if (retag) {
+			it->generation = recoveryActivation;
+			recoveryActivationStates++;
+		}
+		if (hide)
+			it->hiddenByZoom = true;
+		if (retag || hide)
+			journalRecoveryState(key, it.value());
+		return;
+	}
+
+	if (recoveryTransforms.size() >= kMaxRecoveryStates) {
+		// Only older activations can make room. Dropping an earlier capture of
+		// this one would lose an original that this zoom-out still restores.
+		if (recoveryActivationStates >= recoveryTransforms.size()) {
+			if (!recoveryCapWarned) {
+				recoveryCapWarned = true;
+				blog(LOG_WARNING, "[Zoominator] Recovery map full (%d); later items are unprotected.",
+				     (int)kMaxRecoveryStates);
+			}
+			return;
+		}
+		evictOldestRecoveryGeneration();
+	}
+
+	OrigState entry = state;
+	entry.generation = recoveryActivation;
+	recoveryTransforms.insert(key, entry);
+	recoveryActivationStates++;
+	recoveryIndexDirty = true;
+	journalRecoveryState(key, entry);
+}
+
+void ZoominatorController::evictOldestRecoveryGeneration()
+{
+	// Callers make sure an entry from an older activation exists.
+	uint64_t oldest = recoveryActivation;
+	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it)
+		oldest = std::min(oldest, it->generation);
+
+	const qsizetype before = recoveryTransforms.size();
+	for (auto it = recoveryTransforms.begin(); it != recoveryTransforms.end();)
+		it = it->generation == oldest ? recoveryTransforms.erase(it) : std::next(it);
+	recoveryIndexDirty = true;
+	compactRecoveryJournal();
+
+	blog(LOG_INFO, "[Zoominator] Recovery map full; dropped %d entr(ies) from an older activation.",
+	     (int)(before - recoveryTransforms.size()));
+}
+
+void ZoominatorController::pruneUnresolvedRecoveryStates()
+{
+	// Nothing in the loaded collection matched. Entries from the newest
+	// activation may belong to another collection and are kept; older ones
+	// refer to items that no longer exist.
+	uint64_t newest = 0;
+	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it)
+		newest = std::max(newest, it->generation);
+	for (auto it = legacyRecoveryTransforms.constBegin(); it != legacyRecoveryTransforms.constEnd(); ++it)
+		newest = std::max(newest, it->generation);
+
+	const qsizetype before = recoveryTransforms.size() + legacyRecoveryTransforms.size();
+	for (auto it = recoveryTransforms.begin(); it != recoveryTransforms.end();) {
+		if (it->generation >= newest) {
+			++it;
+			continue;
+		}
+		recoveryActivationStates -= it->generation == recoveryActivation ? 1 : 0;
+		it = recoveryTransforms.erase(it);
+	}
+	for (auto it = legacyRecoveryTransforms.begin(); it != legacyRecoveryTransforms.end();)
+		it = it->generation < newest ? legacyRecoveryTransforms.erase(it) : std::next(it);
+	const qsizetype after = recoveryTransforms.size() + legacyRecoveryTransforms.size();
+	if (after == before)
+		return;
+
+	recoveryIndexDirty = true;
+	logi(debug, "[Zoominator] Pruned %d unresolved recovery entr(ies).", (int)(before - after));
+	if (after == 0)
+		clearRecoveryActive();
+	else
+		compactRecoveryJournal();
+}
+
+void ZoominatorController::journalRecoveryState(const SceneItemKey &key, const OrigState &state)
+{
+	ZoominatorJournalRecord r;
+	memcpy(r.sceneUuid, key.scene, sizeof(r.sceneUuid));
+	memcpy(r.sourceUuid, key.source, sizeof(r.sourceUuid));
+	r.itemId = key.itemId;
+	appendJournalRecord(r, state);
+}
+
+void ZoominatorController::journalLegacyRecoveryState(const QString &key, const OrigState &state)
+{
+	if (key.isEmpty())
+		return;
+
+	ZoominatorJournalRecord r;
+	r.legacyKey = key.toStdString();
+	appendJournalRecord(r, state);
+}
+
+void ZoominatorController::appendJournalRecord(ZoominatorJournalRecord &r, const OrigState &state)
+{
+	if (!state.valid)
+		return;
+
+	r.activation = state.generation;
+	r.posX = state.pos.x;
+	r.posY = state.pos.y;
+	r.scaleX = state.scale.x;
+	r.scaleY = state.scale.y;
+	r.rot = state.rot;
+	r.align = state.align;
+	r.boundsType = (uint32_t)state.boundsType;
+	r.boundsAlign = state.boundsAlign;
+	r.boundsX = state.bounds.x;
+	r.boundsY = state.bounds.y;
+	r.cropLeft = state.crop.left;
+	r.cropTop = state.crop.top;
+	r.cropRight = state.crop.right;
+	r.cropBottom = state.crop.bottom;
+	r.hiddenByZoom = state.hiddenByZoom;
+	zoominator_journal_encode(recoveryJournalBatch, r);
+}
+
+void ZoominatorController::flushRecoveryJournal()
+{
+	if (recoveryJournalBatch.empty())
+		return;
+
+	const QString p = recoveryJournalPath();
+	if (!p.isEmpty())
+		settingsWriter.submitAppend(p.toUtf8().toStdString(), recoveryJournalBatch);
+	recoveryJournalBatch.clear();
+}
+
+void ZoominatorController::resetRecoveryJournal()
+{
+	recoveryJournalBatch.clear();
+	const QString p = recoveryJournalPath();
+	if (!p.isEmpty())
+		settingsWriter.submitText(p.toUtf8().toStdString(), zoominator_journal_header());
+}
+
+void ZoominatorController::compactRecoveryJournal()
+{
+	resetRecoveryJournal();
+	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it)
+		journalRecoveryState(it.key(), it.value());
+	for (auto it = legacyRecoveryTransforms.constBegin(); it != legacyRecoveryTransforms.constEnd(); ++it)
+		journalLegacyRecoveryState(it.key(), it.value());
+	flushRecoveryJournal();
 }
 
 void ZoominatorController::scheduleSettingsSave(int delayMs)
@@ -331,88 +620,169 @@ void ZoominatorController::scheduleSettingsSave(int delayMs)
 	});
 }
 
+void ZoominatorController::rebuildRecoveryIndex()
+{
+	recoveryIndex.clear();
+	for (auto it = recoveryTransforms.constBegin(); it != recoveryTransforms.constEnd(); ++it)
+		recoveryIndex.add(it.key());
+	for (auto it = legacyRecoveryTransforms.constBegin(); it != legacyRecoveryTransforms.constEnd(); ++it)
+		recoveryIndex.addLegacy(it.key().toStdString());
+	recoveryIndexDirty = false;
+}
+
 void ZoominatorController::restoreRecoveryIfNeeded()
 {
 	if (!recoveryActive)
 		return;
 
-	if (recoveryTransforms.isEmpty()) {
+	if (recoveryTransforms.isEmpty() && legacyRecoveryTransforms.isEmpty()) {
 		clearRecoveryActive();
 		return;
 	}
 
+	if (recoveryIndexDirty)
+		rebuildRecoveryIndex();
+
 	restoringRecovery = true;
 
 	obs_frontend_source_list scenes{};
 	obs_frontend_get_scenes(&scenes);
 
+	// Nested scenes also appear in the frontend list, so each scene is walked
+	// once no matter how many parents reference it.
 	struct Ctx {
 		ZoominatorController *ctl = nullptr;
 		int restored = 0;
-		static void enumScene(obs_scene_t *scene, Ctx *ctx)
-		{
-			if (!scene || !ctx || !ctx->ctl)
-				return;
-			obs_scene_enum_items(
-				scene,
-				[](obs_scene_t *, obs_sceneitem_t *item, void *param) -> bool {
-					auto *ctx = static_cast<Ctx *>(param);
-					if (!ctx || !ctx->ctl || !item)
-						return true;
-
-					const QString key = ctx->ctl->sceneItemKey(item);
-					if (!key.isEmpty() && ctx->ctl->recoveryTransforms.contains(key)) {
-						ctx->ctl->applySceneItemTransform(item, ctx->ctl->recoveryTransforms.value(key));
-						ctx->restored++;
-					} else {
-						obs_source_t *src = obs_sceneitem_get_source(item);
-						obs_scene_t *scene = obs_sceneitem_get_scene(item);
-						obs_source_t *sceneSource = scene ? obs_scene_get_source(scene) : nullptr;
-						const char *sceneName = sceneSource ? obs_source_get_name(sceneSource) : nullptr;
-						const char *sourceName = src ? obs_source_get_name(src) : nullptr;
-						if (sceneName && *sceneName && sourceName && *sourceName) {
-							const QString prefix = QStringLiteral("%1::%2::").arg(QString::fromUtf8(sceneName)).arg(QString::fromUtf8(sourceName));
-							QString matched;
-							for (auto it = ctx->ctl->recoveryTransforms.constBegin(); it != ctx->ctl->recoveryTransforms.constEnd(); ++it) {
-								if (!it.key().startsWith(prefix))
-									continue;
-								if (!matched.isEmpty()) {
-									matched.clear();
-									break;
-								}
-								matched = it.key();
-							}
-							if (!matched.isEmpty()) {
-								ctx->ctl->applySceneItemTransform(item, ctx->ctl->recoveryTransforms.value(matched));
-								ctx->restored++;
-							}
-						}
-					}
-
-					obs_source_t *src = obs_sceneitem_get_source(item);
-					obs_scene_t *subScene = src ? obs_scene_from_source(src) : nullptr;
-					if (subScene)
-						Ctx::enumScene(subScene, ctx);
-
-					return true;
-				},
-				ctx);
-		}
+		QSet<obs_scene_t *> visited;
+		QSet<QByteArray> sceneUuids;
+		std::vector<obs_scene_t *> pending;
+		std::vector<obs_sceneitem_t *> queued;
 	};
 
-	Ctx ctx{this};
+	Ctx ctx;
+	ctx.ctl = this;
 	for (size_t i = 0; i < scenes.sources.num; i++) {
 		obs_source_t *sceneSource = scenes.sources.array[i];
 		obs_scene_t *scene = sceneSource ? obs_scene_from_source(sceneSource) : nullptr;
 		if (scene)
-			Ctx::enumScene(scene, &ctx);
+			ctx.pending.push_back(scene);
+	}
+
+	while (!ctx.pending.empty()) {
+		obs_scene_t *scene = ctx.pending.back();
+		ctx.pending.pop_back();
+		if (ctx.visited.contains(scene))
+			continue;
+		ctx.visited.insert(scene);
+
+		uint8_t sceneUuid[16];
+		if (parse_uuid(obs_source_get_uuid(obs_scene_get_source(scene)), sceneUuid))
+			ctx.sceneUuids.insert(QByteArray(reinterpret_cast<const char *>(sceneUuid), sizeof(sceneUuid)));
+
+		// Names are only needed to match entries written by older versions.
+		struct SceneCtx {
+			Ctx *ctx = nullptr;
+			std::string legacyPrefix;
+			std::string legacyPair;
+		};
+		SceneCtx sceneCtx;
+		sceneCtx.ctx = &ctx;
+		if (!legacyRecoveryTransforms.isEmpty()) {
+			obs_source_t *sceneSource = obs_scene_get_source(scene);
+			const char *sceneName = sceneSource ? obs_source_get_name(sceneSource) : nullptr;
+			if (sceneName && *sceneName)
+				sceneCtx.legacyPrefix.assign(sceneName).append("::");
+		}
+
+		obs_scene_enum_items(
+			scene,
+			[](obs_scene_t *, obs_sceneitem_t *item, void *param) -> bool {
+				auto *sceneCtx = static_cast<SceneCtx *>(param);
+				Ctx *ctx = sceneCtx ? sceneCtx->ctx : nullptr;
+				if (!ctx || !item)
+					return true;
+
+				ZoominatorController *ctl = ctx->ctl;
+				const OrigState *state = nullptr;
+				SceneItemKey key;
+				if (ctl->sceneItemKey(item, key)) {
+					if (const SceneItemKey *hit = ctl->recoveryIndex.resolve(key)) {
+						auto exact = ctl->recoveryTransforms.constFind(*hit);
+						if (exact != ctl->recoveryTransforms.constEnd())
+							state = &exact.value();
+					}
+				}
+
+				obs_source_t *src = obs_sceneitem_get_source(item);
+				const char *sourceName = src ? obs_source_get_name(src) : nullptr;
+				if (!state && !sceneCtx->legacyPrefix.empty() && sourceName && *sourceName) {
+					sceneCtx->legacyPair.assign(sceneCtx->legacyPrefix).append(sourceName);
+					if (const std::string *hit = ctl->recoveryIndex.resolveLegacy(
+						    sceneCtx->legacyPair, obs_sceneitem_get_id(item))) {
+						const QString legacyKey = QString::fromStdString(*hit);
+						auto legacy = ctl->legacyRecoveryTransforms.constFind(legacyKey);
+						if (legacy != ctl->legacyRecoveryTransforms.constEnd())
+							state = &legacy.value();
+					}
+				}
+
+				// Queued rather than applied so each parent scene takes its
+				// lock once for all of its restored items.
+				if (state && state->valid) {
+					obs_sceneitem_addref(item);
+					ctx->queued.push_back(item);
+					TransformOp op;
+					op.item = item;
+					op.restore = state;
+					ctl->queueTransform(op);
+					ctx->restored++;
+				}
+
+				obs_scene_t *subScene = src ? obs_scene_from_source(src) : nullptr;
+				if (subScene)
+					ctx->pending.push_back(subScene);
+				return true;
+			},
+			&sceneCtx);
 	}
 
+	commitTransformPlan();
+	for (obs_sceneitem_t *item : ctx.queued)
+		obs_sceneitem_release(item);
 	obs_frontend_source_list_free(&scenes);
 
 	restoringRecovery = false;
+	logi(debug, "[Zoominator] Recovery restored %d item(s) across %d scene(s).", ctx.restored,
+	     (int)ctx.visited.size());
 	if (ctx.restored > 0)
+		dropRecoveryStatesForScenes(ctx.sceneUuids);
+	else
+		pruneUnresolvedRecoveryStates();
+}
+
+void ZoominatorController::dropRecoveryStatesForScenes(const QSet<QByteArray> &sceneUuids)
+{
+	// Everything keyed to a scene of the loaded collection has either been
+	// restored or refers to an item that is gone. Entries for other
+	// collections' scenes survive. Legacy entries carry no collection, so a
+	// successful restore retires them all.
+	for (auto it = recoveryTransforms.begin(); it != recoveryTransforms.end();) {
+		const QByteArray scene = QByteArray::fromRawData(reinterpret_cast<const char *>(it.key().scene),
+								 sizeof(it.key().scene));
+		if (!sceneUuids.contains(scene)) {
+			++it;
+			continue;
+		}
+		recoveryActivationStates -= it->generation == recoveryActivation ? 1 : 0;
+		it = recoveryTransforms.erase(it);
+	}
+	legacyRecoveryTransforms.clear();
+	recoveryIndexDirty = true;
+
+	if (recoveryTransforms.isEmpty())
 		clearRecoveryActive();
+	else if (!shuttingDown)
+		compactRecoveryJournal();
 }
 
 void ZoominatorController::requestRecoveryRestore()
@@ -428,22 +798,45 @@ void ZoominatorController::frontendEventCallback(enum obs_frontend_event event,
 	if (!ctl || ctl->shuttingDown)
 		return;
 
+	if (event == OBS_FRONTEND_EVENT_SCENE_CHANGED)
+		QTimer::singleShot(0, ctl, [ctl]() { ctl->wakeFromIdle(); });
+
+	// Switching profiles resets video with that profile's canvas size.
+	if (event == OBS_FRONTEND_EVENT_PROFILE_CHANGED)
+		ctl->invalidateGeometry();
+
+	if (event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP || event == OBS_FRONTEND_EVENT_EXIT) {
+		ctl->releaseZoomContainer();
+		ctl->releaseCameraFilter();
+		ctl->releaseMarkerItem();
+		ctl->sceneMirror.reset();
+	}
+
 	if (event == OBS_FRONTEND_EVENT_FINISHED_LOADING ||
 	    event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED ||
-	    event == OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED) {
+	    event == OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED)
+		QTimer::singleShot(0, ctl, [ctl]() { remove_stale_camera_filters(ctl->cameraFilter); });
+
+	// The collection is fully loaded by the time these fire, so one restore
+	// pass and one legacy marker sweep per load is enough.
+	if (event == OBS_FRONTEND_EVENT_FINISHED_LOADING || event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED) {
 		QTimer::singleShot(0, ctl, [ctl]() { cleanup_legacy_marker_items_all_scenes(ctl->markerSource); });
 		QTimer::singleShot(0, ctl, [ctl]() { ctl->requestRecoveryRestore(); });
-		QTimer::singleShot(500, ctl, [ctl]() { ctl->requestRecoveryRestore(); });
 	}
 }
 
 void ZoominatorController::markRecoveryActive()
 {
+	// Every zoom starts a new generation, even while an older crash is still
+	// waiting to be restored.
+	recoveryActivation = std::max(recoveryActivation + 1, (uint64_t)QDateTime::currentMSecsSinceEpoch());
+	recoveryActivationStates = 0;
+	recoveryCapWarned = false;
 	if (recoveryActive)
 		return;
 	recoveryActive = true;
 	if (!shuttingDown)
-		saveSettings();
+		writeRecoveryFlag();
 }
 
 void ZoominatorController::clearRecoveryActive()
@@ -451,31 +844,71 @@ void ZoominatorController::clearRecoveryActive()
 	if (!recoveryActive)
 		return;
 	recoveryActive = false;
-	if (!shuttingDown)
-		saveSettings();
+	recoveryTransforms.clear();
+	legacyRecoveryTransforms.clear();
+	recoveryActivationStates = 0;
+	recoveryIndexDirty = true;
+	if (!shuttingDown) {
+		writeRecoveryFlag();
+		resetRecoveryJournal();
+	}
 }
 
-static void ensure_parent_dir_exists(const QString &filePath)
+void ZoominatorController::finishRecoveryActivation()
 {
-	if (filePath.isEmpty())
+	// A normal zoom-out has restored everything this activation captured.
+	// Entries kept from older, unrestored activations stay armed until a
+	// collection they belong to is loaded.
+	if (!recoveryActive)
+		return;
+
+	const qsizetype before = recoveryTransforms.size();
+	for (auto it = recoveryTransforms.begin(); it != recoveryTransforms.end();)
+		it = it->generation == recoveryActivation ? recoveryTransforms.erase(it) : std::next(it);
+	recoveryActivationStates = 0;
+
+	if (recoveryTransforms.isEmpty() && legacyRecoveryTransforms.isEmpty()) {
+		clearRecoveryActive();
 		return;
-	QFileInfo fi(filePath);
-	const QString dir = fi.absolutePath();
-	if (dir.isEmpty())
+	}
+	if (recoveryTransforms.size() == before)
+		return;
+
+	recoveryIndexDirty = true;
+	if (!shuttingDown)
+		compactRecoveryJournal();
+}
+
+void ZoominatorController::writeRecoveryFlag()
+{
+	// The flag flips on every zoom, so it lives in its own two-byte file
+	// instead of forcing a rewrite of the full settings JSON.
+	const QString p = recoveryFlagPath();
+	if (!p.isEmpty())
+		settingsWriter.submitText(p.toUtf8().toStdString(), recoveryActive ? "1\n" : "0\n");
+}
+
+void ZoominatorController::readRecoveryFlag()
+{
+	// The flag file wins over the legacy recovery_active key when present.
+	const QString p = recoveryFlagPath();
+	if (p.isEmpty())
 		return;
-	QByteArray dirUtf8 = dir.toUtf8();
-	os_mkdirs(dirUtf8.constData());
+	if (char *flag = os_quick_read_utf8_file(p.toUtf8().constData())) {
+		recoveryActive = flag[0] == '1';
+		bfree(flag);
+	}
 }
 
 void ZoominatorController::initialize()
 {
+	settingsWriter.start();
 	loadSettings();
 	rebuildTriggersFromSettings();
 	obs_frontend_add_event_callback(frontendEventCallback, this);
-	QTimer::singleShot(0, this, [this]() { cleanup_legacy_marker_items_all_scenes(markerSource); });
-	QTimer::singleShot(0, this, [this]() { requestRecoveryRestore(); });
-	QTimer::singleShot(750, this, [this]() { requestRecoveryRestore(); });
-	QTimer::singleShot(2000, this, [this]() { requestRecoveryRestore(); });
+	obs_add_tick_callback(obsVideoTick, this);
+	watchScreenGeometry();
+	QTimer::singleShot(0, this, [this]() { remove_stale_camera_filters(cameraFilter); });
 	installHooks();
 }
 
@@ -483,10 +916,36 @@ void ZoominatorController::shutdown()
 {
 	shuttingDown = true;
 	obs_frontend_remove_event_callback(frontendEventCallback, this);
+	obs_remove_tick_callback(obsVideoTick, this);
 	uninstallHooks();
 	ensureTicking(false);
+	releaseZoomContainer();
+	releaseCameraFilter();
+	releaseMarkerItem();
+	if (markerSource) {
+		obs_source_release(markerSource);
+		markerSource = nullptr;
+	}
+	if (containerScene) {
+		obs_scene_release(containerScene);
+		containerScene = nullptr;
+	}
+	sceneMirror.reset();
 	if (dialog)
 		dialog->close();
+	settingsWriter.stop();
+}
+
+void ZoominatorController::logTickProfile()
+{
+	tickProfiler.log();
+}
+
+ZoominatorStatsSnapshot ZoominatorController::statsSnapshot() const
+{
+	ZoominatorStatsSnapshot snapshot = stats.snapshot(os_gettime_ns());
+	snapshot.settingsWrites = settingsWriter.writeCount();
+	return snapshot;
 }
 
 void ZoominatorController::showDialog()
@@ -504,12 +963,14 @@ void ZoominatorController::showDialog()
 void ZoominatorController::loadSettings()
 {
 	screenKey.clear();
+	invalidateGeometry();
 
 	hotkeySequence = QStringLiteral("Ctrl+F1");
 	hotkeyMode = QStringLiteral("hold");
 
 	triggerType = QStringLiteral("keyboard");
 	mouseButton = QStringLiteral("x1");
+	inputBackend = QStringLiteral("auto");
 	modCtrl = true;
 	modAlt = false;
 	modShift = false;
@@ -529,6 +990,8 @@ void ZoominatorController::loadSettings()
 	followMouse = true;
 	followMouseRuntimeEnabled = true;
 	followSpeed = 8.0;
+	frameSync = false;
+	zoomMethod = QStringLiteral("items");
 	portraitCover = true;
 	showCursorMarker = false;
 	markerOnlyOnClick = false;
@@ -543,8 +1006,14 @@ void ZoominatorController::loadSettings()
 
 	QByteArray pUtf8 = p.toUtf8();
 	obs_data_t *data = obs_data_create_from_json_file_safe(pUtf8.constData(), "bak");
-	if (!data)
+	if (!data) {
+		// No settings saved yet, but a zoom may still have been journaled.
+		recoveryActive = false;
+		readRecoveryFlag();
+		loadRecoveryJournal();
+		compactRecoveryJournal();
 		return;
+	}
 
 	auto getStr = [&](const char *key) -> QString {
 		const char *v = obs_data_get_string(data, key);
@@ -641,6 +1110,9 @@ void ZoominatorController::loadSettings()
 	mouseButton = getStr("mouse_button");
 	if (mouseButton.isEmpty())
 		mouseButton = "x1";
+	inputBackend = getStr("input_backend");
+	if (inputBackend != "xinput2" && inputBackend != "evdev")
+		inputBackend = "auto";
 
 	if (obs_data_has_user_value(data, "mod_ctrl"))
 		modCtrl = obs_data_get_bool(data, "mod_ctrl");
@@ -689,6 +1161,11 @@ void ZoominatorController::loadSettings()
 		followSpeed = obs_data_get_double(data, "follow_speed");
 	if (followSpeed <= 0.1)
 		followSpeed = 8.0;
+	if (obs_data_has_user_value(data, "frame_sync"))
+		frameSync = obs_data_get_bool(data, "frame_sync");
+	zoomMethod = getStr("zoom_method");
+	if (zoomMethod != "container" && zoomMethod != "filter")
+		zoomMethod = "items";
 
 	if (obs_data_has_user_value(data, "portrait_cover"))
 		portraitCover = obs_data_get_bool(data, "portrait_cover");
@@ -724,7 +1201,13 @@ void ZoominatorController::loadSettings()
 	}
 
 	recoveryActive = obs_data_get_bool(data, "recovery_active");
-	loadRecoveryMap(data);
+	readRecoveryFlag();
+	// Older versions kept the map inside zoominator.json; carry it over once so
+	// the next settings save can drop it. Compacting also rewrites journals
+	// from older versions in the current format before anything is appended.
+	if (!loadRecoveryJournal())
+		loadRecoveryMap(data);
+	compactRecoveryJournal();
 
 	obs_data_release(data);
 
@@ -736,17 +1219,35 @@ void ZoominatorController::loadSettings()
 
 void ZoominatorController::notifySettingsChanged()
 {
+	wakeFromIdle();
 	emit settingsChanged();
 }
 
 void ZoominatorController::saveSettings()
+{
+	writeSettingsSnapshot();
+
+	invalidateGeometry();
+	rebuildTriggersFromSettings();
+#ifdef __linux__
+	if (inputBackend != installedInputBackend) {
+		uninstallHooks();
+		installHooks();
+	}
+#endif
+	if (isTicking())
+		ensureTicking(true);
+	else
+		wakeFromIdle();
+	emit settingsChanged();
+}
+
+void ZoominatorController::writeSettingsSnapshot()
 {
 	const QString p = configPath();
 	if (p.isEmpty())
 		return;
 
-	ensure_parent_dir_exists(p);
-
 	obs_data_t *data = obs_data_create();
 	obs_data_set_string(data, "screen_key", screenKey.toUtf8().constData());
 	obs_data_set_string(data, "hotkey", hotkeySequence.toUtf8().constData());
@@ -755,6 +1256,7 @@ void ZoominatorController::saveSettings()
 
 	obs_data_set_string(data, "trigger_type", triggerType.toUtf8().constData());
 	obs_data_set_string(data, "mouse_button", mouseButton.toUtf8().constData());
+	obs_data_set_string(data, "input_backend", inputBackend.toUtf8().constData());
 	obs_data_set_bool(data, "mod_ctrl", modCtrl);
 	obs_data_set_bool(data, "mod_alt", modAlt);
 	obs_data_set_bool(data, "mod_shift", modShift);
@@ -774,6 +1276,8 @@ void ZoominatorController::saveSettings()
 	obs_data_set_bool(data, "follow_mouse", followMouse);
 	followMouseRuntimeEnabled = true;
 	obs_data_set_double(data, "follow_speed", followSpeed);
+	obs_data_set_bool(data, "frame_sync", frameSync);
+	obs_data_set_string(data, "zoom_method", zoomMethod.toUtf8().constData());
 	obs_data_set_bool(data, "portrait_cover", portraitCover);
 	obs_data_set_bool(data, "show_cursor_marker", showCursorMarker);
 	obs_data_set_bool(data, "marker_only_on_click", markerOnlyOnClick);
@@ -782,7 +1286,6 @@ void ZoominatorController::saveSettings()
 	obs_data_set_int(data, "marker_thickness", markerThickness);
 	obs_data_set_bool(data, "debug", debug);
 	obs_data_set_bool(data, "recovery_active", recoveryActive);
-	saveRecoveryMap(data);
 
 	obs_data_array_t *exArr = obs_data_array_create();
 	for (const QString &exName : excludedSources) {
@@ -795,31 +1298,134 @@ void ZoominatorController::saveSettings()
 	obs_data_array_release(exArr);
 
 	QByteArray pUtf8 = p.toUtf8();
-	obs_data_save_json_safe(data, pUtf8.constData(), "tmp", "bak");
-	obs_data_release(data);
+	settingsWriter.submitJson(pUtf8.toStdString(), data);
 
-	logi(debug, "[Zoominator] Saved settings to: %s", pUtf8.constData());
+	logi(debug, "[Zoominator] Queued settings write to: %s", pUtf8.constData());
+}
 
-	rebuildTriggersFromSettings();
-	emit settingsChanged();
+bool ZoominatorController::isTicking() const
+{
+	return tickTimer.isActive() || videoTickArmed.load(std::memory_order_relaxed);
 }
 
 void ZoominatorController::ensureTicking(bool on)
 {
+	// In frame-sync mode the OBS video tick drives onTick (see obsVideoTick),
+	// so the QTimer stays idle and only the armed flag is toggled.
+	const bool useVideo = on && frameSync;
+	const bool useTimer = on && !frameSync;
 	if (on) {
-		if (!tickTimer.isActive())
-			tickTimer.start();
+		idle = false;
+		settledTicks = 0;
+	}
+
+	if (!useVideo && videoTickArmed.exchange(false))
+		pendingFrameNs.store(0);
+	if (useVideo && !videoTickArmed.exchange(true))
+		frameTickSeconds = 0.0;
+
+	if (useTimer) {
+		if (!tickTimer.isActive())
+			tickTimer.start();
 	} else {
 		if (tickTimer.isActive())
 			tickTimer.stop();
 	}
 }
 
+void ZoominatorController::enterIdle()
+{
+	if (idle)
+		return;
+	idle = true;
+	ensureTicking(false);
+	motionWakeArmed.store(true, std::memory_order_release);
+	logi(debug, "[Zoominator] Camera at rest; ticking suspended.");
+}
+
+void ZoominatorController::wakeFromIdle()
+{
+	if (!idle || shuttingDown)
+		return;
+	lastTickMs = 0;
+	ensureTicking(true);
+	logi(debug, "[Zoominator] Camera woken from idle.");
+}
+
+obs_scene_t *ZoominatorController::currentMirroredScene()
+{
+	obs_source_t *sceneSource = obs_frontend_get_current_scene();
+	obs_scene_t *scene = sceneSource ? obs_scene_from_source(sceneSource) : nullptr;
+	sceneMirror.bind(scene);
+	if (sceneSource)
+		obs_source_release(sceneSource);
+	return scene;
+}
+
+void ZoominatorController::sceneMirrorChanged(void *param)
+{
+	auto *ctl = static_cast<ZoominatorController *>(param);
+	if (!ctl || ctl->shuttingDown)
+		return;
+
+	// Scene signals can arrive from any thread; collapse bursts (e.g. a
+	// collection load) into a single queued wake.
+	if (!ctl->sceneWakePending.exchange(true))
+		QMetaObject::invokeMethod(
+			ctl,
+			[ctl]() {
+				ctl->sceneWakePending.store(false);
+				ctl->wakeFromIdle();
+			},
+			Qt::QueuedConnection);
+}
+
+bool ZoominatorController::hasMotionEvents() const
+{
+#ifdef _WIN32
+	return mouseHook != nullptr;
+#elif defined(__APPLE__)
+	return eventTap != nullptr;
+#elif defined(__linux__)
+	return xiDisplay != nullptr || evdevInput.running();
+#else
+	return false;
+#endif
+}
+
+void ZoominatorController::obsVideoTick(void *param, float seconds)
+{
+	auto *ctl = static_cast<ZoominatorController *>(param);
+	if (!ctl || !ctl->videoTickArmed.load(std::memory_order_relaxed))
+		return;
+
+	// Runs on the OBS graphics thread once per rendered frame. Frame times are
+	// accumulated so a busy UI thread gets one coalesced tick covering every
+	// frame it missed instead of a queue of stale ones.
+	const uint64_t ns = std::max<uint64_t>(1, (uint64_t)((double)seconds * 1000000000.0));
+	if (ctl->pendingFrameNs.fetch_add(ns) == 0)
+		QMetaObject::invokeMethod(ctl, &ZoominatorController::onVideoFrame, Qt::QueuedConnection);
+}
+
+void ZoominatorController::onVideoFrame()
+{
+	const uint64_t ns = pendingFrameNs.exchange(0);
+	if (ns == 0 || shuttingDown || !videoTickArmed.load(std::memory_order_relaxed))
+		return;
+
+	frameTickSeconds = (double)ns / 1000000000.0;
+	onTick();
+}
+
 void ZoominatorController::startZoomIn()
 {
-	markRecoveryActive();
+	if (zoomMethod != "filter")
+		markRecoveryActive();
+	stats.markTrigger(os_gettime_ns());
 	lastTickMs = 0;
 	animDir = +1;
+	cursorSamples.clear();
+	followCursorValid = false;
 	ensureTicking(true);
 }
 
@@ -827,10 +1433,7 @@ void ZoominatorController::startZoomOut()
 {
 	lastTickMs = 0;
 	animDir = -1;
-	markerClickFlashStartMs = 0;
-	markerClickFlashHoldUntilMs = 0;
-	markerClickFlashFadeOutEndMs = 0;
-	markerClickHasPos = false;
+	clearClickHalos();
 	ensureTicking(true);
 }
 
@@ -841,6 +1444,10 @@ void ZoominatorController::resetState()
 	zoomActive = false;
 	animT = 0.0;
 	animDir = 0;
+	idle = false;
+	applySettled = false;
+	settledTicks = 0;
+	lastTickCursorValid = false;
 	followHasPos = false;
 	targetHasPos = false;
 	tickDeltaSeconds = 1.0 / 60.0;
@@ -848,14 +1455,15 @@ void ZoominatorController::resetState()
 	lastTransformApplyMs = 0;
 	lastFollowAnchorValid = false;
 	sceneItems.clear();
+	tickPlanner.clear();
+	releaseZoomContainer();
+	releaseCameraFilter();
+	markerItemScale = 1.0f;
 	sceneContentBoundsValid = false;
 	sceneContentMin = {};
 	sceneContentMax = {};
 	markerCurrentOpacity = -1;
-	markerClickFlashStartMs = 0;
-	markerClickFlashHoldUntilMs = 0;
-	markerClickFlashFadeOutEndMs = 0;
-	markerClickHasPos = false;
+	clearClickHalos();
 	obs_source_t *sceneSource = obs_frontend_get_current_scene();
 	if (sceneSource) {
 		obs_scene_t *scene = obs_scene_from_source(sceneSource);
@@ -865,94 +1473,263 @@ void ZoominatorController::resetState()
 	}
 }
 
-static QString make_screen_key_from_rect(int x, int y, int w, int h)
+bool ZoominatorController::isMarkerSource(obs_source_t *src) const
 {
-	return QStringLiteral("%1,%2,%3,%4").arg(x).arg(y).arg(w).arg(h);
+	if (!src)
+		return false;
+	if (src == markerSource)
+		return true;
+	const char *srcId = obs_source_get_id(src);
+	if (srcId && strcmp(srcId, kZoominatorMarkerSourceId) == 0)
+		return true;
+	return source_name_starts_with(obs_source_get_name(src), kZoominatorMarkerSourceName);
 }
 
-void ZoominatorController::enumerateTargetItemsInCurrentScene(std::vector<obs_sceneitem_t *> &items) const
+void ZoominatorController::enumerateTargetItemsInCurrentScene(std::vector<obs_sceneitem_t *> &items)
 {
 	items.clear();
 
-	obs_source_t *sceneSource = obs_frontend_get_current_scene();
-	if (!sceneSource)
+	if (!currentMirroredScene())
 		return;
 
-	obs_scene_t *scene = obs_scene_from_source(sceneSource);
-	obs_source_release(sceneSource);
+	// Nested scenes are expanded by the mirror; their own items follow them in
+	// the entry list, so only leaf items are collected here.
+	for (const ZoominatorSceneMirror::Entry &entry : sceneMirror.entries()) {
+		if (!entry.item || !entry.source || entry.isScene)
+			continue;
+		if (isMarkerSource(entry.source))
+			continue;
+
+		if (!excludedSources.isEmpty()) {
+			const char *srcName = obs_source_get_name(entry.source);
+			if (srcName && excludedSources.contains(QString::fromUtf8(srcName)))
+				continue;
+		}
+
+		items.push_back(entry.item);
+	}
+}
+
+obs_sceneitem_t *ZoominatorController::ensureZoomContainer(obs_scene_t *scene)
+{
+	releaseZoomContainer();
 	if (!scene)
-		return;
+		return nullptr;
 
-	struct Ctx {
-		std::vector<obs_sceneitem_t *> *items = nullptr;
-		const QSet<QString> *excluded = nullptr;
+	if (!containerScene)
+		containerScene = obs_scene_create_private(kZoominatorContainerName);
+	if (!containerScene)
+		return nullptr;
 
-		static bool is_marker_item(obs_sceneitem_t *item)
-		{
-			if (!item)
-				return true;
-			obs_source_t *src = obs_sceneitem_get_source(item);
-			if (!src)
-				return true;
-			if (src == ZoominatorController::instance().markerSource)
-				return true;
-			const char *srcName = obs_source_get_name(src);
-			const char *srcId = obs_source_get_id(src);
-			if (srcId && QString::fromUtf8(srcId) == QString::fromUtf8(kZoominatorMarkerSourceId))
-				return true;
-			return source_name_starts_with(srcName, kZoominatorMarkerSourceName);
+	// Snapshot the members first: adding the container and hiding the originals
+	// both change the mirrored scene.
+	std::vector<obs_sceneitem_t *> members;
+	for (const ZoominatorSceneMirror::Entry &entry : sceneMirror.entries()) {
+		if (!entry.topLevel || !entry.item || !entry.source)
+			continue;
+		if (!obs_sceneitem_visible(entry.item) || isMarkerSource(entry.source))
+			continue;
+		if (!excludedSources.isEmpty()) {
+			const char *srcName = obs_source_get_name(entry.source);
+			if (srcName && excludedSources.contains(QString::fromUtf8(srcName)))
+				continue;
 		}
+		members.push_back(entry.item);
+	}
+	if (members.empty())
+		return nullptr;
 
-		static void enum_scene(obs_scene_t *scene, Ctx *ctx)
-		{
-			if (!scene || !ctx || !ctx->items)
-				return;
-			obs_scene_enum_items(
-				scene,
-				[](obs_scene_t *, obs_sceneitem_t *item, void *param) -> bool {
-					auto *ctx = static_cast<Ctx *>(param);
-					if (!ctx || !ctx->items || !item)
-						return true;
-					if (is_marker_item(item))
-						return true;
-
-					obs_source_t *src = obs_sceneitem_get_source(item);
-					if (!src)
-						return true;
-
-					if (obs_scene_t *subScene = obs_scene_from_source(src)) {
-						enum_scene(subScene, ctx);
-						return true;
-					}
+	// The container takes the slot of the lowest member, so excluded items
+	// below the zoomed content (a full-frame background, say) stay below it.
+	int lowestMember = INT_MAX;
+	for (obs_sceneitem_t *item : members)
+		lowestMember = std::min(lowestMember, obs_sceneitem_get_order_position(item));
 
-					
-					if (ctx->excluded && !ctx->excluded->isEmpty()) {
-						const char *srcName = obs_source_get_name(src);
-						if (srcName &&
-						    ctx->excluded->contains(QString::fromUtf8(srcName)))
-							return true;
-					}
+	for (obs_sceneitem_t *item : members) {
+		obs_sceneitem_t *copy = obs_scene_add(containerScene, obs_sceneitem_get_source(item));
+		if (!copy)
+			continue;
 
-					ctx->items->push_back(item);
-					return true;
-				},
-				ctx);
-		}
-	};
+		obs_transform_info info{};
+		obs_sceneitem_get_info2(item, &info);
+		obs_sceneitem_set_info2(copy, &info);
+
+		obs_sceneitem_crop crop{};
+		obs_sceneitem_get_crop(item, &crop);
+		obs_sceneitem_set_crop(copy, &crop);
+
+		obs_sceneitem_set_scale_filter(copy, obs_sceneitem_get_scale_filter(item));
+		obs_sceneitem_set_blending_method(copy, obs_sceneitem_get_blending_method(item));
+		obs_sceneitem_set_blending_mode(copy, obs_sceneitem_get_blending_mode(item));
+	}
+
+	containerItem = obs_scene_add(scene, obs_scene_get_source(containerScene));
+	if (!containerItem) {
+		releaseZoomContainer();
+		return nullptr;
+	}
+	obs_sceneitem_addref(containerItem);
+	obs_sceneitem_set_order_position(containerItem, lowestMember);
+	obs_sceneitem_set_locked(containerItem, true);
+
+	// The copies are already showing, so hiding the originals does not
+	// deactivate their sources.
+	for (obs_sceneitem_t *item : members) {
+		OrigState hidden = readSceneItemTransform(item);
+		hidden.hiddenByZoom = true;
+		SceneItemKey key;
+		if (sceneItemKey(item, key))
+			rememberRecoveryState(key, hidden);
+
+		obs_sceneitem_addref(item);
+		obs_sceneitem_set_visible(item, false);
+		containerHiddenItems.push_back(item);
+	}
+
+	// Positions as they will be once the container is gone again.
+	containerHiddenOrder.clear();
+	for (obs_sceneitem_t *item : containerHiddenItems) {
+		const int pos = obs_sceneitem_get_order_position(item);
+		containerHiddenOrder.push_back(pos > lowestMember ? pos - 1 : pos);
+	}
+
+	logi(debug, "[Zoominator] Zoom container holds %d item(s).", (int)containerHiddenItems.size());
+	return containerItem;
+}
+
+void ZoominatorController::releaseZoomContainer()
+{
+	// Show the originals before the container goes, so their sources stay
+	// active throughout.
+	for (obs_sceneitem_t *item : containerHiddenItems) {
+		obs_sceneitem_set_visible(item, true);
+		SceneItemKey key;
+		auto it = sceneItemKey(item, key) ? recoveryTransforms.find(key) : recoveryTransforms.end();
+		if (it != recoveryTransforms.end())
+			it->hiddenByZoom = false;
+	}
+
+	if (containerItem) {
+		obs_sceneitem_remove(containerItem);
+		obs_sceneitem_release(containerItem);
+		containerItem = nullptr;
+	}
+
+	// Removing the container normally puts every original back in its slot;
+	// reapply the recorded ones in case the scene was reordered meanwhile.
+	for (size_t i = 0; i < containerHiddenItems.size() && i < containerHiddenOrder.size(); i++) {
+		obs_sceneitem_t *item = containerHiddenItems[i];
+		if (obs_sceneitem_get_order_position(item) != containerHiddenOrder[i])
+			obs_sceneitem_set_order_position(item, containerHiddenOrder[i]);
+	}
+
+	for (obs_sceneitem_t *item : containerHiddenItems)
+		obs_sceneitem_release(item);
+	containerHiddenItems.clear();
+	containerHiddenOrder.clear();
+
+	if (containerScene) {
+		std::vector<obs_sceneitem_t *> copies;
+		obs_scene_enum_items(
+			containerScene,
+			[](obs_scene_t *, obs_sceneitem_t *item, void *param) -> bool {
+				static_cast<std::vector<obs_sceneitem_t *> *>(param)->push_back(item);
+				return true;
+			},
+			&copies);
+		for (obs_sceneitem_t *item : copies)
+			obs_sceneitem_remove(item);
+	}
+}
+
+bool ZoominatorController::ensureCameraFilter(obs_scene_t *scene)
+{
+	releaseCameraFilter();
+	obs_source_t *sceneSource = scene ? obs_scene_get_source(scene) : nullptr;
+	if (!sceneSource)
+		return false;
+
+	cameraFilter = obs_source_create_private(kZoominatorCameraFilterId, kZoominatorCameraFilterName, nullptr);
+	if (!cameraFilter)
+		return false;
+
+	cameraFilterParent = obs_source_get_ref(sceneSource);
+	if (!cameraFilterParent) {
+		obs_source_release(cameraFilter);
+		cameraFilter = nullptr;
+		return false;
+	}
+
+	obs_source_filter_add(cameraFilterParent, cameraFilter);
+	return true;
+}
+
+void ZoominatorController::releaseCameraFilter()
+{
+	if (cameraFilterParent) {
+		if (cameraFilter)
+			obs_source_filter_remove(cameraFilterParent, cameraFilter);
+		obs_source_release(cameraFilterParent);
+		cameraFilterParent = nullptr;
+	}
+	if (cameraFilter) {
+		obs_source_release(cameraFilter);
+		cameraFilter = nullptr;
+	}
+}
+
+static void remove_stale_camera_filters(obs_source_t *activeFilter)
+{
+	obs_frontend_source_list scenes{};
+	obs_frontend_get_scenes(&scenes);
+	for (size_t i = 0; i < scenes.sources.num; i++) {
+		obs_source_t *sceneSource = scenes.sources.array[i];
+		if (!sceneSource)
+			continue;
+
+		struct Ctx {
+			obs_source_t *active = nullptr;
+			std::vector<obs_source_t *> stale;
+		};
 
-	Ctx ctx{&items, &excludedSources};
-	Ctx::enum_scene(scene, &ctx);
+		Ctx ctx{activeFilter, {}};
+		obs_source_enum_filters(
+			sceneSource,
+			[](obs_source_t *, obs_source_t *filter, void *param) {
+				auto *ctx = static_cast<Ctx *>(param);
+				const char *id = filter ? obs_source_get_unversioned_id(filter) : nullptr;
+				if (filter != ctx->active && id && strcmp(id, kZoominatorCameraFilterId) == 0)
+					ctx->stale.push_back(filter);
+			},
+			&ctx);
+
+		for (obs_source_t *filter : ctx.stale)
+			obs_source_filter_remove(sceneSource, filter);
+	}
+	obs_frontend_source_list_free(&scenes);
 }
 
 bool ZoominatorController::getSelectedScreenRect(int &x, int &y, int &w, int &h) const
 {
+	// The key is parsed once per change so the per-sample lookup compares
+	// integers instead of formatting a string for every screen.
+	if (parsedScreenKey != screenKey) {
+		parsedScreenKey = screenKey;
+		const QStringList parts = screenKey.split(QLatin1Char(','));
+		parsedScreenKeyValid = parts.size() == 4;
+		for (int i = 0; parsedScreenKeyValid && i < 4; i++)
+			parsedScreenRect[i] = parts[i].trimmed().toInt(&parsedScreenKeyValid);
+	}
+
 	const auto screens = QGuiApplication::screens();
 	for (auto *screen : screens) {
 		if (!screen)
 			continue;
 		const QRect g = screen->geometry();
-		const QString key = make_screen_key_from_rect(g.x(), g.y(), g.width(), g.height());
-		if (screenKey.isEmpty() || key == screenKey) {
+		const bool keyMatches = parsedScreenKeyValid && g.x() == parsedScreenRect[0] &&
+					g.y() == parsedScreenRect[1] && g.width() == parsedScreenRect[2] &&
+					g.height() == parsedScreenRect[3];
+		if (screenKey.isEmpty() || keyMatches) {
 			x = g.x();
 			y = g.y();
 			w = g.width();
@@ -974,12 +1751,34 @@ bool ZoominatorController::getCursorPos(int &x, int &y) const
 	
 	
 	
+#ifdef __linux__
+	if (latestCursorValid.load(std::memory_order_acquire)) {
+		const uint64_t packed = latestCursor.load(std::memory_order_acquire);
+		x = (int)(int32_t)(uint32_t)(packed >> 32);
+		y = (int)(int32_t)(uint32_t)(packed & 0xffffffffu);
+		return true;
+	}
+#endif
 	const QPoint p = QCursor::pos();
 	x = p.x();
 	y = p.y();
 	return true;
 }
 
+void ZoominatorController::publishCursorSample(int x, int y, uint64_t tNs)
+{
+	latestCursor.store(((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y, std::memory_order_release);
+	latestCursorValid.store(true, std::memory_order_release);
+
+	CursorSample sample;
+	sample.tNs = tNs;
+	sample.x = x;
+	sample.y = y;
+	cursorSamples.push(sample);
+	if (motionWakeArmed.exchange(false, std::memory_order_acq_rel))
+		QMetaObject::invokeMethod(this, [this]() { wakeFromIdle(); }, Qt::QueuedConnection);
+}
+
 static bool get_monitor_capture_selector(obs_source_t *src, QString &selector, int &monitorId, bool &hasId)
 {
 	selector.clear();
@@ -1223,16 +2022,6 @@ static bool parse_obs_window_selector(const QString &sel, QString &title, QStrin
 	return true;
 }
 
-static bool mods_current(bool wantCtrl, bool wantAlt, bool wantShift, bool wantWin,
-			 bool wantLeftCtrl, bool wantRightCtrl, bool wantLeftAlt, bool wantRightAlt,
-			 bool wantLeftShift, bool wantRightShift, bool wantLeftWin, bool wantRightWin);
-
-static bool mods_current(bool wantCtrl, bool wantAlt, bool wantShift, bool wantWin)
-{
-	return mods_current(wantCtrl, wantAlt, wantShift, wantWin, false, false, false, false, false, false,
-			    false, false);
-}
-
 static std::wstring to_w(const QString &s)
 {
 	return s.toStdWString();
@@ -1497,20 +2286,36 @@ struct MonitorInfoLite {
 	int x, y, w, h;
 };
 
-static std::vector<MonitorInfoLite> enum_monitors()
+// Connected outputs read once through XRRGetScreenResourcesCurrent, which
+// returns the server's current configuration without re-probing outputs
+// (XRRGetScreenResources can stall for tens of milliseconds and makes some
+// desktops flicker). The cache is dropped when the query connection sees a
+// RandR change notification. UI thread only, like the connection itself.
+struct MonitorTopology {
+	bool valid = false;
+	bool notifySelected = false;
+	int rrEventBase = 0;
+	std::vector<MonitorInfoLite> monitors;
+	QHash<QString, int> byName;
+};
+static MonitorTopology g_monitorTopology;
+
+static void reset_monitor_topology()
 {
-	std::vector<MonitorInfoLite> out;
-	Display *dpy = XOpenDisplay(nullptr);
-	if (!dpy)
-		return out;
+	g_monitorTopology = MonitorTopology();
+}
 
-	int screen = DefaultScreen(dpy);
-	Window root = RootWindow(dpy, screen);
-	XRRScreenResources *res = XRRGetScreenResources(dpy, root);
-	if (!res) {
-		XCloseDisplay(dpy);
-		return out;
-	}
+static void load_monitor_topology(Display *dpy)
+{
+	MonitorTopology &topo = g_monitorTopology;
+	topo.monitors.clear();
+	topo.byName.clear();
+	topo.valid = true;
+
+	Window root = RootWindow(dpy, DefaultScreen(dpy));
+	XRRScreenResources *res = XRRGetScreenResourcesCurrent(dpy, root);
+	if (!res)
+		return;
 
 	for (int i = 0; i < res->noutput; i++) {
 		XRROutputInfo *oi = XRRGetOutputInfo(dpy, res, res->outputs[i]);
@@ -1531,14 +2336,47 @@ static std::vector<MonitorInfoLite> enum_monitors()
 		m.y = (int)ci->y;
 		m.w = (int)ci->width;
 		m.h = (int)ci->height;
-		out.push_back(m);
+		topo.byName.insert(m.name, (int)topo.monitors.size());
+		topo.monitors.push_back(m);
 		XRRFreeCrtcInfo(ci);
 		XRRFreeOutputInfo(oi);
 	}
 
 	XRRFreeScreenResources(res);
-	XCloseDisplay(dpy);
-	return out;
+}
+
+static const std::vector<MonitorInfoLite> &enum_monitors()
+{
+	MonitorTopology &topo = g_monitorTopology;
+	Display *dpy = shared_x11_display();
+	if (!dpy) {
+		reset_monitor_topology();
+		return topo.monitors;
+	}
+
+	if (!topo.notifySelected) {
+		int errorBase = 0;
+		if (XRRQueryExtension(dpy, &topo.rrEventBase, &errorBase)) {
+			XRRSelectInput(dpy, RootWindow(dpy, DefaultScreen(dpy)),
+				       RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
+			topo.notifySelected = true;
+		}
+	}
+
+	// Only RandR notifications are selected on the query connection, so any
+	// queued event means the topology moved. XPending reads without a round trip.
+	while (topo.notifySelected && XPending(dpy) > 0) {
+		XEvent ev;
+		XNextEvent(dpy, &ev);
+		if (ev.type == topo.rrEventBase + RRScreenChangeNotify || ev.type == topo.rrEventBase + RRNotify) {
+			XRRUpdateConfiguration(&ev);
+			topo.valid = false;
+		}
+	}
+
+	if (!topo.valid)
+		load_monitor_topology(dpy);
+	return topo.monitors;
 }
 
 struct LinuxRect {
@@ -1547,7 +2385,7 @@ struct LinuxRect {
 
 static bool match_monitor_rect(obs_source_t *src, LinuxRect &rcOut)
 {
-	auto mons = enum_monitors();
+	const auto &mons = enum_monitors();
 	if (mons.empty())
 		return false;
 
@@ -1557,13 +2395,13 @@ static bool match_monitor_rect(obs_source_t *src, LinuxRect &rcOut)
 	get_monitor_capture_selector(src, selector, monId, hasId);
 
 	if (!selector.isEmpty()) {
-		for (auto &m : mons) {
-			if (m.name == selector) {
-				rcOut = {m.x, m.y, m.w, m.h};
-				return true;
-			}
+		const auto byName = g_monitorTopology.byName.constFind(selector);
+		if (byName != g_monitorTopology.byName.constEnd()) {
+			auto &m = mons[(size_t)byName.value()];
+			rcOut = {m.x, m.y, m.w, m.h};
+			return true;
 		}
-		QRegularExpression re("(\\d+)$");
+		static const QRegularExpression re("(\\d+)$");
 		auto mw = re.match(selector);
 		if (mw.hasMatch()) {
 			int idx = mw.captured(1).toInt();
@@ -1643,7 +2481,7 @@ static bool match_window_rect_for_source(obs_source_t *src, LinuxRect &rcOut)
 	int64_t windowId = obs_data_get_int(s, "window");
 	obs_data_release(s);
 
-	Display *dpy = XOpenDisplay(nullptr);
+	Display *dpy = shared_x11_display();
 	if (!dpy)
 		return false;
 
@@ -1654,7 +2492,6 @@ static bool match_window_rect_for_source(obs_source_t *src, LinuxRect &rcOut)
 			Window child;
 			XTranslateCoordinates(dpy, (Window)windowId, DefaultRootWindow(dpy), 0, 0, &absX, &absY,
 					      &child);
-			XCloseDisplay(dpy);
 			rcOut = {absX, absY, attr.width, attr.height};
 			return true;
 		}
@@ -1666,10 +2503,8 @@ static bool match_window_rect_for_source(obs_source_t *src, LinuxRect &rcOut)
 	if (title.isEmpty() && !wantName.isEmpty())
 		title = wantName;
 
-	if (title.isEmpty() && clazz.isEmpty()) {
-		XCloseDisplay(dpy);
+	if (title.isEmpty() && clazz.isEmpty())
 		return false;
-	}
 
 	Window root = DefaultRootWindow(dpy);
 	Atom netClientList = XInternAtom(dpy, "_NET_CLIENT_LIST", True);
@@ -1729,7 +2564,6 @@ static bool match_window_rect_for_source(obs_source_t *src, LinuxRect &rcOut)
 		}
 	}
 
-	XCloseDisplay(dpy);
 	return found;
 }
 #endif 
@@ -1737,30 +2571,61 @@ static bool match_window_rect_for_source(obs_source_t *src, LinuxRect &rcOut)
 bool ZoominatorController::mapCursorToScenePixels(int cursorX, int cursorY, float &sx, float &sy,
 					   bool &cursorInside) const
 {
-	cursorInside = false;
-	sx = 0.f;
-	sy = 0.f;
+	return geometryContext().screen.map(cursorX, cursorY, sx, sy, cursorInside);
+}
+
+const ZoominatorController::GeometryContext &ZoominatorController::geometryContext() const
+{
+	// libobs has no video reset signal. The cache holds the base canvas size,
+	// so that is the fingerprint: a reset can keep the scaled output size, and
+	// the new video output is often allocated at the old address.
+	obs_video_info ovi{};
+	const bool haveVideo = obs_get_video_info(&ovi);
+	const uint32_t baseW = haveVideo ? ovi.base_width : 0;
+	const uint32_t baseH = haveVideo ? ovi.base_height : 0;
+	if (geometry.valid && geometry.baseW == baseW && geometry.baseH == baseH)
+		return geometry;
+
+	GeometryContext g;
+	g.valid = true;
+	g.baseW = baseW;
+	g.baseH = baseH;
+	if (haveVideo) {
+		g.canvasW = (double)baseW;
+		g.canvasH = (double)baseH;
+	}
 
 	int rx = 0, ry = 0, rw = 0, rh = 0;
-	if (!getSelectedScreenRect(rx, ry, rw, rh) || rw <= 0 || rh <= 0)
-		return false;
+	if (getSelectedScreenRect(rx, ry, rw, rh))
+		g.screen = ZoominatorScreenMap::fromRect(rx, ry, rw, rh, g.canvasW, g.canvasH);
 
-	cursorInside = !(cursorX < rx || cursorX >= rx + rw || cursorY < ry || cursorY >= ry + rh);
-	const int clampedX = std::max(rx, std::min(cursorX, rx + rw - 1));
-	const int clampedY = std::max(ry, std::min(cursorY, ry + rh - 1));
-	const double relX = (clampedX - rx) / (double)rw;
-	const double relY = (clampedY - ry) / (double)rh;
+	geometry = g;
+	return geometry;
+}
 
-	obs_video_info ovi{};
-	const bool haveVi = obs_get_video_info(&ovi);
-	const double cw = haveVi ? (double)ovi.base_width : 1920.0;
-	const double ch = haveVi ? (double)ovi.base_height : 1080.0;
-	if (cw <= 0.0 || ch <= 0.0)
-		return false;
+void ZoominatorController::watchScreenGeometry()
+{
+	auto watch = [this](QScreen *screen) {
+		if (screen)
+			connect(screen, &QScreen::geometryChanged, this, [this]() { screensChanged(); });
+	};
+	for (QScreen *screen : QGuiApplication::screens())
+		watch(screen);
 
-	sx = (float)(relX * cw);
-	sy = (float)(relY * ch);
-	return true;
+	connect(qApp, &QGuiApplication::screenAdded, this, [this, watch](QScreen *screen) {
+		watch(screen);
+		screensChanged();
+	});
+	connect(qApp, &QGuiApplication::screenRemoved, this, [this]() { screensChanged(); });
+	connect(qApp, &QGuiApplication::primaryScreenChanged, this, [this]() { screensChanged(); });
+}
+
+void ZoominatorController::screensChanged()
+{
+	invalidateGeometry();
+#ifdef __linux__
+	updateInputScreens();
+#endif
 }
 
 
@@ -1788,8 +2653,8 @@ static void remove_legacy_marker_items(obs_scene_t *scene, obs_source_t *current
 			const char *name = obs_source_get_name(src);
 			const char *id = obs_source_get_id(src);
 			const bool markerName = source_name_starts_with(name, kZoominatorMarkerSourceName);
-			const bool oldImageSource = id && QString::fromUtf8(id) == QStringLiteral("image_source");
-			const bool oldProceduralMarker = id && QString::fromUtf8(id) == QString::fromUtf8(kZoominatorMarkerSourceId) && src != ctx->current;
+			const bool oldImageSource = id && strcmp(id, "image_source") == 0;
+			const bool oldProceduralMarker = id && strcmp(id, kZoominatorMarkerSourceId) == 0 && src != ctx->current;
 			if (markerName && (oldImageSource || oldProceduralMarker))
 				ctx->items.push_back(item);
 
@@ -1843,71 +2708,9 @@ static void normalize_marker_scene_item(obs_sceneitem_t *item)
 	obs_sceneitem_set_order(item, OBS_ORDER_MOVE_TOP);
 }
 
-void ZoominatorController::rebuildMarkerImage()
-{
-	const int size = std::clamp(markerSize, 6, 512);
-	const QString path = markerImagePath();
-	if (path.isEmpty())
-		return;
-
-	ensure_parent_dir_exists(path);
-
-	QImage img(size, size, QImage::Format_ARGB32_Premultiplied);
-	img.fill(Qt::transparent);
-
-	QPainter painter(&img);
-	painter.setRenderHint(QPainter::Antialiasing, true);
-
-	QColor stroke = QColor::fromRgba(markerColor);
-	if (!stroke.isValid())
-		stroke = QColor(255, 0, 0, 255);
-	if (stroke.alpha() == 0)
-		stroke.setAlpha(255);
-	stroke.setAlpha(255);
-
-	const qreal thickness = std::clamp<qreal>((qreal)markerThickness, 1.0, std::max<qreal>(1.0, size / 2.0 - 2.0));
-	const qreal margin = thickness * 0.5 + 1.5;
-	const QRectF ringRect(margin, margin, size - margin * 2.0, size - margin * 2.0);
-
-	QPen ringPen(stroke);
-	ringPen.setWidthF(thickness);
-	ringPen.setCosmetic(true);
-	painter.setPen(ringPen);
-	painter.setBrush(Qt::NoBrush);
-	painter.drawEllipse(ringRect);
-	painter.end();
-
-	img.save(path, "PNG");
-}
-
-void ZoominatorController::ensureMarkerFilter()
-{
-	if (!markerSource)
-		return;
-
-	if (markerFilter) {
-		obs_source_t *existing = obs_source_get_filter_by_name(markerSource, "ZoominatorOpacity");
-		if (existing) {
-			obs_source_release(existing);
-			return;
-		}
-		obs_source_release(markerFilter);
-		markerFilter = nullptr;
-	}
-
-	obs_data_t *fsettings = obs_data_create();
-	obs_data_set_double(fsettings, "opacity", 100.0);
-	markerFilter = obs_source_create_private("color_filter", "ZoominatorOpacity", fsettings);
-	obs_data_release(fsettings);
-
-	if (markerFilter)
-		obs_source_filter_add(markerSource, markerFilter);
-}
-
 void ZoominatorController::applyMarkerOpacity(int opacity255)
 {
-	ensureMarkerFilter();
-	if (!markerFilter)
+	if (!markerSource)
 		return;
 
 	const int clamped = std::clamp(opacity255, 0, 255);
@@ -1915,11 +2718,7 @@ void ZoominatorController::applyMarkerOpacity(int opacity255)
 		return;
 
 	markerCurrentOpacity = clamped;
-	const double opacityPct = clamped / 255.0 * 100.0;
-	obs_data_t *fsettings = obs_data_create();
-	obs_data_set_double(fsettings, "opacity", opacityPct);
-	obs_source_update(markerFilter, fsettings);
-	obs_data_release(fsettings);
+	zoominator_marker_source_set_ring(markerSource, clamped / 255.0f);
 }
 
 void ZoominatorController::ensureMarkerSource()
@@ -1927,32 +2726,18 @@ void ZoominatorController::ensureMarkerSource()
 	if (markerSource)
 		return;
 
-	rebuildMarkerImage();
-
-	const QString path = markerImagePath();
-	if (path.isEmpty())
-		return;
-
-	obs_data_t *settings = obs_data_create();
-	obs_data_set_string(settings, "file", path.toUtf8().constData());
-	obs_data_set_bool(settings, "unload", false);
-	markerSource = obs_source_create_private("image_source", kZoominatorMarkerSourceName, settings);
-	obs_data_release(settings);
-
-	if (markerSource)
-		ensureMarkerFilter();
+	markerSource = obs_source_create_private(kZoominatorMarkerSourceId, kZoominatorMarkerSourceName, nullptr);
+	markerAppearanceHash = 0;
+	markerCurrentOpacity = -1;
 }
 
-obs_sceneitem_t *ZoominatorController::ensureMarkerItem(obs_scene_t *scene)
+obs_sceneitem_t *ZoominatorController::findMarkerItem(obs_scene_t *scene)
 {
-	if (!scene)
-		return nullptr;
-
-	ensureMarkerSource();
-	if (!markerSource)
+	if (!scene || !markerSource)
 		return nullptr;
 
-	remove_legacy_marker_items(scene, markerSource);
+	if (scene == sceneMirror.scene())
+		return sceneMirror.findTopLevel(markerSource);
 
 	struct Finder {
 		obs_source_t *want = nullptr;
@@ -1974,17 +2759,56 @@ obs_sceneitem_t *ZoominatorController::ensureMarkerItem(obs_scene_t *scene)
 
 	Finder finder{markerSource, nullptr};
 	obs_scene_enum_items(scene, Finder::enum_cb, &finder);
-	if (finder.found) {
-		normalize_marker_scene_item(finder.found);
-		return finder.found;
+	return finder.found;
+}
+
+void ZoominatorController::releaseMarkerItem()
+{
+	if (markerItem.item)
+		obs_sceneitem_release(markerItem.item);
+	markerItem = MarkerItemHandle();
+}
+
+ZoominatorController::MarkerItemHandle *ZoominatorController::markerItemFor(obs_scene_t *scene, bool create)
+{
+	if (!scene || scene != sceneMirror.scene())
+		return nullptr;
+
+	// The mirror generation moves on every item_add/item_remove in the scene
+	// tree and on every rebind, so an unchanged generation proves the cached
+	// item is still live without touching the scene.
+	sceneMirror.sync();
+	if (markerItem.item && markerItem.scene != scene) {
+		// Scene switch: leave no stale ring behind in the scene being left.
+		obs_sceneitem_set_visible(markerItem.item, false);
+		releaseMarkerItem();
 	}
+	if (markerItem.item && markerItem.generation != sceneMirror.generation()) {
+		if (sceneMirror.findTopLevel(markerSource) == markerItem.item)
+			markerItem.generation = sceneMirror.generation();
+		else
+			releaseMarkerItem();
+	}
+	if (markerItem.item || !create)
+		return markerItem.item ? &markerItem : nullptr;
 
-	obs_sceneitem_t *item = obs_scene_add(scene, markerSource);
+	ensureMarkerSource();
+	if (!markerSource)
+		return nullptr;
+
+	obs_sceneitem_t *item = findMarkerItem(scene);
+	if (!item)
+		item = obs_scene_add(scene, markerSource);
 	if (!item)
 		return nullptr;
 
 	normalize_marker_scene_item(item);
-	return item;
+	obs_sceneitem_addref(item);
+	markerItem.scene = scene;
+	markerItem.item = item;
+	markerItem.generation = sceneMirror.generation();
+	markerItem.scale = 1.0f;
+	return &markerItem;
 }
 
 void ZoominatorController::hideMarkerInScene(obs_scene_t *scene)
@@ -1992,30 +2816,12 @@ void ZoominatorController::hideMarkerInScene(obs_scene_t *scene)
 	if (!scene || !markerSource)
 		return;
 
-	remove_legacy_marker_items(scene, markerSource);
-
-	struct Finder {
-		obs_source_t *want = nullptr;
-		obs_sceneitem_t *found = nullptr;
-
-		static bool enum_cb(obs_scene_t *, obs_sceneitem_t *item, void *param)
-		{
-			auto *f = static_cast<Finder *>(param);
-			if (!f || f->found)
-				return false;
-			obs_source_t *src = obs_sceneitem_get_source(item);
-			if (src == f->want) {
-				f->found = item;
-				return false;
-			}
-			return true;
-		}
-	};
-
-	Finder finder{markerSource, nullptr};
-	obs_scene_enum_items(scene, Finder::enum_cb, &finder);
-	if (finder.found)
-		obs_sceneitem_set_visible(finder.found, false);
+	if (MarkerItemHandle *handle = markerItemFor(scene, false)) {
+		obs_sceneitem_set_visible(handle->item, false);
+		return;
+	}
+	if (obs_sceneitem_t *found = findMarkerItem(scene))
+		obs_sceneitem_set_visible(found, false);
 }
 
 void ZoominatorController::updateMarkerAppearance()
@@ -2028,19 +2834,12 @@ void ZoominatorController::updateMarkerAppearance()
 	if (markerSource && markerAppearanceHash == appearanceHash)
 		return;
 
-	rebuildMarkerImage();
 	ensureMarkerSource();
 	if (!markerSource)
 		return;
 
-	const QString path = markerImagePath();
-	obs_data_t *settings = obs_data_create();
-	obs_data_set_string(settings, "file", path.toUtf8().constData());
-	obs_data_set_bool(settings, "unload", false);
-	obs_source_update(markerSource, settings);
-	obs_data_release(settings);
+	zoominator_marker_source_set_appearance(markerSource, markerSize, markerThickness, markerColor);
 	markerAppearanceHash = appearanceHash;
-	markerCurrentOpacity = -1;
 }
 
 
@@ -2050,59 +2849,103 @@ bool ZoominatorController::captureMarkerClickPosition()
 		return false;
 
 	int cx = 0, cy = 0;
+	return getCursorPos(cx, cy) && captureMarkerClickAt(cx, cy);
+}
+
+bool ZoominatorController::captureMarkerClickAt(int cx, int cy)
+{
+	if (!showCursorMarker || !markerOnlyOnClick)
+		return false;
+
 	float mx = 0.f, my = 0.f;
 	bool inside = false;
-	const bool mapped = getCursorPos(cx, cy) && mapCursorToScenePixels(cx, cy, mx, my, inside);
-	if (!mapped || !inside)
+	if (!mapCursorToScenePixels(cx, cy, mx, my, inside) || !inside)
 		return false;
 
-	markerClickX = mx;
-	markerClickY = my;
-	markerClickHasPos = true;
 	const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+	ClickHalo *slot = &clickHalos[0];
+	for (ClickHalo &halo : clickHalos) {
+		if (halo.fadeOutEndMs <= nowMs) {
+			slot = &halo;
+			break;
+		}
+		if (halo.startMs < slot->startMs)
+			slot = &halo;
+	}
+
 	static constexpr qint64 kMarkerFadeInMs = 110;
 	static constexpr qint64 kMarkerHoldMs = 420;
 	static constexpr qint64 kMarkerFadeOutMs = 220;
-	markerClickFlashStartMs = nowMs;
-	markerClickFlashHoldUntilMs = nowMs + kMarkerFadeInMs + kMarkerHoldMs;
-	markerClickFlashFadeOutEndMs = markerClickFlashHoldUntilMs + kMarkerFadeOutMs;
+	slot->x = mx;
+	slot->y = my;
+	slot->startMs = nowMs;
+	slot->holdUntilMs = nowMs + kMarkerFadeInMs + kMarkerHoldMs;
+	slot->fadeOutEndMs = slot->holdUntilMs + kMarkerFadeOutMs;
+	clickHalosEndMs = std::max(clickHalosEndMs, slot->fadeOutEndMs);
 	ensureTicking(true);
 	return true;
 }
 
 bool ZoominatorController::isMarkerFlashActive(qint64 nowMs) const
 {
-	return showCursorMarker && markerOnlyOnClick && markerClickHasPos && markerClickFlashFadeOutEndMs > 0 &&
-	       nowMs < markerClickFlashFadeOutEndMs;
+	return showCursorMarker && markerOnlyOnClick && nowMs < clickHalosEndMs;
 }
 
-int ZoominatorController::currentMarkerOpacity(qint64 nowMs)
+void ZoominatorController::clearClickHalos()
 {
-	if (!showCursorMarker || !markerOnlyOnClick || !markerClickHasPos)
-		return 0;
+	clickHalos.fill(ClickHalo());
+	clickHalosEndMs = 0;
+}
 
+float ZoominatorController::clickHaloOpacity(const ClickHalo &halo, qint64 nowMs)
+{
 	static constexpr qint64 kMarkerFadeInMs = 110;
-	if (markerClickFlashFadeOutEndMs <= 0 || nowMs >= markerClickFlashFadeOutEndMs) {
-		markerClickHasPos = false;
-		markerClickFlashStartMs = 0;
-		markerClickFlashHoldUntilMs = 0;
-		markerClickFlashFadeOutEndMs = 0;
-		return 0;
+	if (nowMs >= halo.fadeOutEndMs)
+		return 0.0f;
+
+	if (nowMs < halo.startMs + kMarkerFadeInMs) {
+		const double tIn = clampd((double)(nowMs - halo.startMs) / (double)kMarkerFadeInMs, 0.0, 1.0);
+		return (float)zoominator_camera_smoothstep(tIn);
 	}
 
-	if (nowMs < markerClickFlashStartMs + kMarkerFadeInMs) {
-		const double tIn = clampd((double)(nowMs - markerClickFlashStartMs) /
-					 (double)std::max<qint64>(1, kMarkerFadeInMs),
-					 0.0, 1.0);
-		return (int)std::round(smoothstep(tIn) * 255.0);
+	if (nowMs < halo.holdUntilMs)
+		return 1.0f;
+
+	const qint64 fadeOutMs = std::max<qint64>(1, halo.fadeOutEndMs - halo.holdUntilMs);
+	const double tOut = clampd((double)(nowMs - halo.holdUntilMs) / (double)fadeOutMs, 0.0, 1.0);
+	return (float)(1.0 - zoominator_camera_smoothstep(tOut));
+}
+
+obs_sceneitem_t *ZoominatorController::placeMarkerItem(obs_scene_t *scene, double x, double y, float scale)
+{
+	MarkerItemHandle *handle = markerItemFor(scene, true);
+	if (!handle)
+		return nullptr;
+
+	updateMarkerAppearance();
+
+	// The item was normalized when the handle was taken; per frame only the
+	// position moves, plus the counter-scale while a scene-space zoom animates.
+	obs_sceneitem_t *item = handle->item;
+	if (handle->scale != scale) {
+		vec2 sc{};
+		sc.x = scale;
+		sc.y = scale;
+		obs_sceneitem_set_scale(item, &sc);
+		handle->scale = scale;
 	}
 
-	if (nowMs < markerClickFlashHoldUntilMs)
-		return 255;
+	vec2 pos{};
+	pos.x = (float)x;
+	pos.y = (float)y;
+	obs_sceneitem_set_pos(item, &pos);
+	stats.recordMarkerUpdate();
 
-	const qint64 fadeOutMs = std::max<qint64>(1, markerClickFlashFadeOutEndMs - markerClickFlashHoldUntilMs);
-	const double tOut = clampd((double)(nowMs - markerClickFlashHoldUntilMs) / (double)fadeOutMs, 0.0, 1.0);
-	return (int)std::round((1.0 - smoothstep(tOut)) * 255.0);
+	if (!obs_sceneitem_visible(item)) {
+		obs_sceneitem_set_visible(item, true);
+		obs_sceneitem_set_order(item, OBS_ORDER_MOVE_TOP);
+	}
+	return item;
 }
 
 void ZoominatorController::updateMarkerPosition(obs_scene_t *scene, double x, double y, int opacity255)
@@ -2116,27 +2959,68 @@ void ZoominatorController::updateMarkerPosition(obs_scene_t *scene, double x, do
 		return;
 	}
 
-	obs_sceneitem_t *item = ensureMarkerItem(scene);
-	if (!item)
-		return;
-
-	updateMarkerAppearance();
+	ensureMarkerSource();
 	applyMarkerOpacity(clampedOpacity);
+	placeMarkerItem(scene, x, y, markerItemScale);
+}
 
-	if (!scene_item_pointer_is_live(scene, item))
+void ZoominatorController::updateClickHalos(obs_scene_t *scene, const ZoominatorCamera &camera, bool sceneSpace)
+{
+	const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+	ZoominatorMarkerHalo halos[kZoominatorMarkerMaxHalos];
+	size_t count = 0;
+	for (ClickHalo &halo : clickHalos) {
+		if (halo.fadeOutEndMs <= nowMs) {
+			halo.fadeOutEndMs = 0;
+			continue;
+		}
+		const float opacity = clickHaloOpacity(halo, nowMs);
+		if (opacity <= 0.0f)
+			continue;
+		ZoominatorMarkerHalo &out = halos[count++];
+		out.x = sceneSpace ? halo.x : (float)camera.mapX(halo.x);
+		out.y = sceneSpace ? halo.y : (float)camera.mapY(halo.y);
+		out.opacity = opacity;
+	}
+	if (nowMs >= clickHalosEndMs)
+		clickHalosEndMs = 0;
+	if (count == 0) {
+		hideMarkerInScene(scene);
 		return;
+	}
 
-	normalize_marker_scene_item(item);
+	// The source spans the canvas so halo positions are plain scene pixels. In
+	// scene space the camera zooms the rings with everything else, so they are
+	// drawn at 1/z to keep their on-screen size.
+	const GeometryContext &geo = geometryContext();
+	const uint32_t cw = (uint32_t)std::max(1.0, geo.canvasW);
+	const uint32_t ch = (uint32_t)std::max(1.0, geo.canvasH);
+	ensureMarkerSource();
+	zoominator_marker_source_set_halos(markerSource, cw, ch, markerItemScale, halos, count);
+	markerCurrentOpacity = -1;
+	placeMarkerItem(scene, cw * 0.5, ch * 0.5, 1.0f);
+}
 
-	vec2 pos{};
-	pos.x = (float)x;
-	pos.y = (float)y;
-	obs_sceneitem_set_pos(item, &pos);
+void ZoominatorController::updateMarker(obs_scene_t *scene, const ZoominatorCamera &camera, bool sceneSpace,
+					bool hasPoint, float sceneX, float sceneY)
+{
+	if (!scene)
+		return;
 
-	if (!obs_sceneitem_visible(item)) {
-		obs_sceneitem_set_visible(item, true);
-		obs_sceneitem_set_order(item, OBS_ORDER_MOVE_TOP);
+	ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::Marker);
+	if (showCursorMarker && markerOnlyOnClick) {
+		updateClickHalos(scene, camera, sceneSpace);
+		return;
 	}
+
+	if (!showCursorMarker || !hasPoint) {
+		hideMarkerInScene(scene);
+		return;
+	}
+
+	double x = 0.0, y = 0.0;
+	ZoominatorTickPlanner::markerPoint(camera, sceneSpace, sceneX, sceneY, x, y);
+	updateMarkerPosition(scene, x, y, 255);
 }
 
 void ZoominatorController::captureOriginal(obs_sceneitem_t *item)
@@ -2147,59 +3031,33 @@ void ZoominatorController::captureOriginal(obs_sceneitem_t *item)
 	if (!orig.valid)
 		return;
 
-	float renderedW = 0.0f;
-	float renderedH = 0.0f;
-
-	obs_source_t *src = obs_sceneitem_get_source(item);
-	float visibleW = 0.0f;
-	float visibleH = 0.0f;
-	if (src) {
-		const float sw = (float)obs_source_get_width(src);
-		const float sh = (float)obs_source_get_height(src);
-		visibleW = sw - (float)orig.crop.left - (float)orig.crop.right;
-		visibleH = sh - (float)orig.crop.top - (float)orig.crop.bottom;
-	}
-	if (visibleW <= 0.0f)
-		visibleW = 1.0f;
-	if (visibleH <= 0.0f)
-		visibleH = 1.0f;
-
-	if (orig.boundsType == OBS_BOUNDS_NONE || orig.bounds.x <= 0.0f ||
-	    orig.bounds.y <= 0.0f) {
-		renderedW = visibleW * orig.scale.x;
-		renderedH = visibleH * orig.scale.y;
-	} else {
-		const float sx = orig.bounds.x / visibleW;
-		const float sy = orig.bounds.y / visibleH;
-
-		renderedW = orig.bounds.x;
-		renderedH = orig.bounds.y;
-		orig.effectiveScale.x = sx;
-		orig.effectiveScale.y = sy;
-	}
-
-	if (orig.boundsType == OBS_BOUNDS_NONE || orig.bounds.x <= 0.0f ||
-	    orig.bounds.y <= 0.0f) {
-		orig.effectiveScale.x = renderedW / visibleW;
-		orig.effectiveScale.y = renderedH / visibleH;
+	ZoominatorItemGeometry geometry;
+	geometry.posX = orig.pos.x;
+	geometry.posY = orig.pos.y;
+	geometry.scaleX = orig.scale.x;
+	geometry.scaleY = orig.scale.y;
+	geometry.useBounds = orig.boundsType != OBS_BOUNDS_NONE;
+	geometry.boundsW = orig.bounds.x;
+	geometry.boundsH = orig.bounds.y;
+	geometry.alignX = (orig.align & OBS_ALIGN_RIGHT) ? 1 : (orig.align & OBS_ALIGN_LEFT) ? -1 : 0;
+	geometry.alignY = (orig.align & OBS_ALIGN_BOTTOM) ? 1 : (orig.align & OBS_ALIGN_TOP) ? -1 : 0;
+
+	if (obs_source_t *src = obs_sceneitem_get_source(item)) {
+		geometry.visibleW = (float)obs_source_get_width(src) - (float)orig.crop.left - (float)orig.crop.right;
+		geometry.visibleH = (float)obs_source_get_height(src) - (float)orig.crop.top - (float)orig.crop.bottom;
 	}
 
-	orig.effectivePos = orig.pos;
-	if (orig.align & OBS_ALIGN_RIGHT)
-		orig.effectivePos.x -= renderedW;
-	else if (!(orig.align & OBS_ALIGN_LEFT))
-		orig.effectivePos.x -= renderedW * 0.5f;
-
-	if (orig.align & OBS_ALIGN_BOTTOM)
-		orig.effectivePos.y -= renderedH;
-	else if (!(orig.align & OBS_ALIGN_TOP))
-		orig.effectivePos.y -= renderedH * 0.5f;
+	const ZoominatorEffectiveTransform effective = zoominator_camera_effective_transform(geometry);
+	orig.effectivePos.x = effective.posX;
+	orig.effectivePos.y = effective.posY;
+	orig.effectiveScale.x = effective.scaleX;
+	orig.effectiveScale.y = effective.scaleY;
 
 	orig.valid = true;
 
-	const QString key = sceneItemKey(item);
-	if (!key.isEmpty())
-		recoveryTransforms.insert(key, orig);
+	SceneItemKey key;
+	if (item != containerItem && sceneItemKey(item, key))
+		rememberRecoveryState(key, orig);
 
 	SceneItemState state{};
 	state.item = item;
@@ -2214,8 +3072,15 @@ void ZoominatorController::captureOriginalSceneItems(const std::vector<obs_scene
 	for (auto *item : items)
 		captureOriginal(item);
 
-	if (recoveryActive && !sceneItems.empty())
-		saveSettings();
+	tickPlanner.clear();
+	for (const auto &state : sceneItems)
+		tickPlanner.add(state.item, state.orig.effectivePos.x, state.orig.effectivePos.y,
+				state.orig.effectiveScale.x, state.orig.effectiveScale.y);
+
+	{
+		ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::SettingsSave);
+		flushRecoveryJournal();
+	}
 
 	for (const auto &state : sceneItems) {
 		if (!state.item || !state.orig.valid)
@@ -2268,38 +3133,105 @@ void ZoominatorController::restoreOriginalSceneItems(const std::vector<obs_scene
 void ZoominatorController::restoreOriginalSceneItemsFromState()
 {
 	for (const auto &state : sceneItems) {
-		if (state.item && state.orig.valid)
-			applySceneItemTransform(state.item, state.orig);
+		if (!state.item || !state.orig.valid)
+			continue;
+		TransformOp op;
+		op.item = state.item;
+		op.restore = &state.orig;
+		queueTransform(op);
 	}
+	commitTransformPlan();
 }
 
-void ZoominatorController::applyZoomToScene(double t)
+void ZoominatorController::stepFollow(float tx, float ty, double dt)
 {
-	if (sceneItems.empty())
+	if (dt <= 0.0)
 		return;
 
-	obs_source_t *sceneSource = obs_frontend_get_current_scene();
-	obs_scene_t *scene = sceneSource ? obs_scene_from_source(sceneSource) : nullptr;
-	if (sceneSource)
-		obs_source_release(sceneSource);
+	const double dx = (double)tx - (double)followX;
+	const double dy = (double)ty - (double)followY;
+	const double dist = std::sqrt(dx * dx + dy * dy);
+
+	// Smooth but responsive mouse-follow. The UI speed now controls both
+	// interpolation strength and the maximum travel per frame. Low speed gives
+	// cinematic drift; high speed follows quickly without snapping to raw mouse input.
+	const double effectiveSpeed = clampd(followSpeed, 0.25, 30.0);
+	const double deadZonePx = clampd(10.0 - effectiveSpeed * 0.22, 2.0, 10.0);
+	if (dist <= deadZonePx)
+		return;
+
+	const double adjustedDist = dist - deadZonePx;
+	const double nx = dx / dist;
+	const double ny = dy / dist;
+
+	// Response limits are expressed per 33 ms reference tick and rescaled by dt,
+	// so sub-stepping over cursor samples converges exactly like one full tick.
+	const double refTicks = dt * 30.0;
+	const double minResponse = 1.0 - std::pow(0.98, refTicks);
+	const double maxResponse = 1.0 - std::pow(0.18, refTicks);
+	const double response = 1.0 - std::exp(-(1.8 + effectiveSpeed * 1.15) * dt);
+	double stepLen = adjustedDist * clampd(response, minResponse, maxResponse);
+
+	const double maxPixelsPerSecond = 240.0 + effectiveSpeed * 185.0;
+	const double maxStep = maxPixelsPerSecond * dt;
+	if (stepLen > maxStep)
+		stepLen = maxStep;
+
+	followX = (float)((double)followX + nx * stepLen);
+	followY = (float)((double)followY + ny * stepLen);
+}
+
+void ZoominatorController::integrateFollow(float mx, float my)
+{
+	const uint64_t nowNs = os_gettime_ns();
+	const uint64_t spanNs = (uint64_t)(tickDeltaSeconds * 1000000000.0);
+	uint64_t prevNs = nowNs > spanNs ? nowNs - spanNs : 0;
+	float curX = followCursorValid ? followCursorX : mx;
+	float curY = followCursorValid ? followCursorY : my;
+
+	// Walk the cursor samples collected since the last tick so the follow filter
+	// sees the path the pointer took, not only where it ended up.
+	CursorSample sample;
+	while (cursorSamples.pop(sample)) {
+		float sx = 0.f, sy = 0.f;
+		bool inside = false;
+		if (!mapCursorToScenePixels(sample.x, sample.y, sx, sy, inside))
+			continue;
+		if (sample.tNs > prevNs && sample.tNs < nowNs) {
+			stepFollow(curX, curY, (double)(sample.tNs - prevNs) / 1000000000.0);
+			prevNs = sample.tNs;
+		}
+		curX = sx;
+		curY = sy;
+	}
+
+	stepFollow(mx, my, (double)(nowNs - prevNs) / 1000000000.0);
+	followCursorX = mx;
+	followCursorY = my;
+	followCursorValid = true;
+}
 
+void ZoominatorController::applyZoomToScene(double t)
+{
+	if (sceneItems.empty() && !cameraFilter)
+		return;
+
+	obs_scene_t *scene = currentMirroredScene();
 	if (!scene)
 		return;
 
-	std::vector<obs_sceneitem_t *> liveItems;
-	collect_live_scene_items(scene, liveItems);
-	auto isLiveItem = [&liveItems](obs_sceneitem_t *item) {
-		return item && std::find(liveItems.begin(), liveItems.end(), item) != liveItems.end();
-	};
+	sceneMirror.sync();
 
-	const double tt = smoothstep(clampd(t, 0.0, 1.0));
-	const double zTarget = (zoomFactor <= 1.0) ? 1.0 : zoomFactor;
-	const double z = 1.0 + (zTarget - 1.0) * tt;
+	const double z = zoominator_camera_zoom_at(t, zoomFactor);
 
-	obs_video_info ovi{};
-	const bool haveVi = obs_get_video_info(&ovi);
-	const double cw = haveVi ? (double)ovi.base_width : 1920.0;
-	const double ch = haveVi ? (double)ovi.base_height : 1080.0;
+	// With the camera filter the marker lives in scene space and is zoomed
+	// along with everything else, so it is counter-scaled to keep its size.
+	const bool sceneSpaceMarker = cameraFilter != nullptr;
+	markerItemScale = sceneSpaceMarker ? (float)(1.0 / z) : 1.0f;
+
+	const GeometryContext &geo = geometryContext();
+	const double cw = geo.canvasW;
+	const double ch = geo.canvasH;
 	const double centerX = cw * 0.5;
 	const double centerY = ch * 0.5;
 
@@ -2314,7 +3246,11 @@ void ZoominatorController::applyZoomToScene(double t)
 	int cx = 0, cy = 0;
 	float mx = 0.f, my = 0.f;
 	bool inside = false;
-	const bool mapped = getCursorPos(cx, cy) && mapCursorToScenePixels(cx, cy, mx, my, inside);
+	bool mapped = false;
+	{
+		ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::CursorMap);
+		mapped = getCursorPos(cx, cy) && mapCursorToScenePixels(cx, cy, mx, my, inside);
+	}
 
 	if (followMouse && followMouseRuntimeEnabled) {
 		targetHasPos = false;
@@ -2323,44 +3259,27 @@ void ZoominatorController::applyZoomToScene(double t)
 				followX = mx;
 				followY = my;
 				followHasPos = true;
+				cursorSamples.clear();
+				followCursorX = mx;
+				followCursorY = my;
+				followCursorValid = true;
 			} else {
-				const double dx = (double)mx - (double)followX;
-				const double dy = (double)my - (double)followY;
-				const double dist = std::sqrt(dx * dx + dy * dy);
-
-				// Smooth but responsive mouse-follow. The UI speed now controls both
-				// interpolation strength and the maximum travel per frame. Low speed gives
-				// cinematic drift; high speed follows quickly without snapping to raw mouse input.
-				const double effectiveSpeed = clampd(followSpeed, 0.25, 30.0);
-				const double deadZonePx = clampd(10.0 - effectiveSpeed * 0.22, 2.0, 10.0);
-				if (dist > deadZonePx) {
-					const double adjustedDist = dist - deadZonePx;
-					const double nx = dx / dist;
-					const double ny = dy / dist;
-
-					const double response = 1.0 - std::exp(-(1.8 + effectiveSpeed * 1.15) * tickDeltaSeconds);
-					double stepLen = adjustedDist * clampd(response, 0.02, 0.82);
-
-					const double maxPixelsPerSecond = 240.0 + effectiveSpeed * 185.0;
-					const double maxStep = maxPixelsPerSecond * tickDeltaSeconds;
-					if (stepLen > maxStep)
-						stepLen = maxStep;
-
-					followX = (float)((double)followX + nx * stepLen);
-					followY = (float)((double)followY + ny * stepLen);
-				}
+				ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::Follow);
+				integrateFollow(mx, my);
 			}
 			fx = followX;
 			fy = followY;
 			anchorX = followX;
 			anchorY = followY;
 		} else if (followHasPos) {
+			cursorSamples.clear();
 			fx = followX;
 			fy = followY;
 			anchorX = followX;
 			anchorY = followY;
 		}
 	} else {
+		cursorSamples.clear();
 		if (!targetHasPos) {
 			if (followHasPos) {
 				targetX = followX;
@@ -2380,60 +3299,47 @@ void ZoominatorController::applyZoomToScene(double t)
 		anchorY = targetY;
 	}
 
-	if (showCursorMarker) {
-		if (markerOnlyOnClick) {
-			if (markerClickHasPos) {
-				markerSceneX = markerClickX;
-				markerSceneY = markerClickY;
-				markerHasPoint = true;
-			}
-		} else if (mapped) {
-			markerSceneX = mx;
-			markerSceneY = my;
-			markerHasPoint = true;
-		}
-	}
-
-	const double baseMinX = sceneContentBoundsValid ? (double)sceneContentMin.x : 0.0;
-	const double baseMinY = sceneContentBoundsValid ? (double)sceneContentMin.y : 0.0;
-	const double baseMaxX = sceneContentBoundsValid ? (double)sceneContentMax.x : cw;
-	const double baseMaxY = sceneContentBoundsValid ? (double)sceneContentMax.y : ch;
-	const double refMinX = (double)anchorX + (baseMinX - (double)fx) * z;
-	const double refMaxX = (double)anchorX + (baseMaxX - (double)fx) * z;
-	const double refMinY = (double)anchorY + (baseMinY - (double)fy) * z;
-	const double refMaxY = (double)anchorY + (baseMaxY - (double)fy) * z;
-	const double minOffsetX = cw - refMaxX;
-	const double maxOffsetX = -refMinX;
-	const double minOffsetY = ch - refMaxY;
-	const double maxOffsetY = -refMinY;
-
-	double offsetX = 0.0;
-	double offsetY = 0.0;
-
-	if (minOffsetX <= maxOffsetX) {
-		offsetX = clampd(0.0, minOffsetX, maxOffsetX);
-	} else {
-		offsetX = (minOffsetX + maxOffsetX) * 0.5;
+	if (showCursorMarker && !markerOnlyOnClick && mapped) {
+		markerSceneX = mx;
+		markerSceneY = my;
+		markerHasPoint = true;
 	}
 
-	if (minOffsetY <= maxOffsetY) {
-		offsetY = clampd(0.0, minOffsetY, maxOffsetY);
-	} else {
-		offsetY = (minOffsetY + maxOffsetY) * 0.5;
-	}
+	ZoominatorCamera camera;
+	camera.zoom = z;
+	camera.anchorX = anchorX;
+	camera.anchorY = anchorY;
+	camera.focusX = fx;
+	camera.focusY = fy;
+
+	ZoominatorBounds content;
+	content.minX = sceneContentBoundsValid ? (double)sceneContentMin.x : 0.0;
+	content.minY = sceneContentBoundsValid ? (double)sceneContentMin.y : 0.0;
+	content.maxX = sceneContentBoundsValid ? (double)sceneContentMax.x : cw;
+	content.maxY = sceneContentBoundsValid ? (double)sceneContentMax.y : ch;
+	zoominator_camera_clamp_offset(camera, content, cw, ch);
 
 	const qint64 nowApplyMs = QDateTime::currentMSecsSinceEpoch();
+
+	// The camera is settled once the anchor it was last applied at has stopped
+	// moving, the cursor is still and no click flash is fading; onTick uses this
+	// to suspend ticking until the next input or scene event.
+	const bool cursorStill = !mapped || (lastTickCursorValid && mx == lastTickCursorX && my == lastTickCursorY);
+	const bool anchorStill = lastFollowAnchorValid && anchorX == lastFollowAnchorX && anchorY == lastFollowAnchorY;
+	applySettled = animDir == 0 && animT >= 1.0 && cursorStill && anchorStill && !isMarkerFlashActive(nowApplyMs);
+	lastTickCursorValid = mapped;
+	lastTickCursorX = mx;
+	lastTickCursorY = my;
+
 	const bool steadyFollow = followMouse && followMouseRuntimeEnabled && animDir == 0 && animT >= 0.999;
 	if (steadyFollow) {
 		const float dx = anchorX - lastFollowAnchorX;
 		const float dy = anchorY - lastFollowAnchorY;
 		const bool anchorMovedEnough = !lastFollowAnchorValid || ((dx * dx + dy * dy) >= 1.0f);
 		if (!anchorMovedEnough && nowApplyMs - lastTransformApplyMs < 16) {
-			if (scene && showCursorMarker && markerHasPoint) {
-				const double markerDisplayX = (double)anchorX + ((double)markerSceneX - (double)fx) * z + offsetX;
-				const double markerDisplayY = (double)anchorY + ((double)markerSceneY - (double)fy) * z + offsetY;
-				updateMarkerPosition(scene, markerDisplayX, markerDisplayY, 255);
-			}
+			if (showCursorMarker)
+				updateMarker(scene, camera, sceneSpaceMarker, markerHasPoint, markerSceneX,
+					     markerSceneY);
 			return;
 		}
 	}
@@ -2443,73 +3349,80 @@ void ZoominatorController::applyZoomToScene(double t)
 	lastFollowAnchorY = anchorY;
 	lastFollowAnchorValid = true;
 
-	const uint32_t topLeftAlign = OBS_ALIGN_LEFT | OBS_ALIGN_TOP;
-	for (auto &state : sceneItems) {
-		if (!state.item || !state.orig.valid || !isLiveItem(state.item))
-			continue;
-
-		if (!state.normalized) {
-			if (obs_sceneitem_get_bounds_type(state.item) != OBS_BOUNDS_NONE)
-				obs_sceneitem_set_bounds_type(state.item, OBS_BOUNDS_NONE);
-			if (obs_sceneitem_get_alignment(state.item) != topLeftAlign)
-				obs_sceneitem_set_alignment(state.item, topLeftAlign);
-			state.normalized = true;
+	{
+		ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::Transform);
+		if (cameraFilter) {
+			zoominator_camera_filter_set_camera(cameraFilter, (float)z, (float)camera.translateX(),
+							    (float)camera.translateY());
 		}
 
-		vec2 sc{};
-		sc.x = state.orig.effectiveScale.x * (float)z;
-		sc.y = state.orig.effectiveScale.y * (float)z;
-
-		vec2 pos{};
-		pos.x = (float)((double)anchorX +
-				((double)state.orig.effectivePos.x - (double)fx) * z + offsetX);
-		pos.y = (float)((double)anchorY +
-				((double)state.orig.effectivePos.y - (double)fy) * z + offsetY);
-
-		if (!state.lastAppliedValid || !nearly_equal_vec2(state.lastAppliedScale, sc)) {
-			obs_sceneitem_set_scale(state.item, &sc);
-			state.lastAppliedScale = sc;
+		for (size_t i = 0; i < sceneItems.size() && i < tickPlanner.size(); i++) {
+			const SceneItemState &state = sceneItems[i];
+			tickPlanner.setLive(i, state.item && state.orig.valid && sceneMirror.contains(state.item));
 		}
-
-		if (!state.lastAppliedValid || !nearly_equal_vec2(state.lastAppliedPos, pos)) {
-			obs_sceneitem_set_pos(state.item, &pos);
-			state.lastAppliedPos = pos;
+		tickPlanner.plan(camera);
+
+		const uint32_t topLeftAlign = OBS_ALIGN_LEFT | OBS_ALIGN_TOP;
+		for (const ZoominatorPlanOp &planned : tickPlanner.ops()) {
+			TransformOp op;
+			op.item = sceneItems[planned.index].item;
+			if (planned.normalize) {
+				op.clearBounds = obs_sceneitem_get_bounds_type(op.item) != OBS_BOUNDS_NONE;
+				op.alignTopLeft = obs_sceneitem_get_alignment(op.item) != topLeftAlign;
+			}
+			op.setScale = planned.setScale;
+			op.scale.x = planned.scaleX;
+			op.scale.y = planned.scaleY;
+			op.setPos = planned.setPos;
+			op.pos.x = planned.posX;
+			op.pos.y = planned.posY;
+			if (op.setPos || op.setScale || op.clearBounds || op.alignTopLeft)
+				queueTransform(op);
 		}
-
-		state.lastAppliedValid = true;
+		commitTransformPlan();
+		stats.recordItems(tickPlanner.applied(), tickPlanner.skipped());
+		stats.recordFrameApplied(os_gettime_ns());
 	}
 
-	if (scene) {
-		int markerOpacity = 255;
-		if (showCursorMarker && markerHasPoint && markerOnlyOnClick) {
-			const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
-			markerOpacity = currentMarkerOpacity(nowMs);
-		}
-
-		if (showCursorMarker && markerHasPoint && markerOpacity > 0) {
-			const double markerDisplayX =
-				(double)anchorX + ((double)markerSceneX - (double)fx) * z + offsetX;
-			const double markerDisplayY =
-				(double)anchorY + ((double)markerSceneY - (double)fy) * z + offsetY;
-			updateMarkerPosition(scene, markerDisplayX, markerDisplayY, markerOpacity);
-		} else {
-			hideMarkerInScene(scene);
-		}
-	}
+	updateMarker(scene, camera, sceneSpaceMarker, markerHasPoint, markerSceneX, markerSceneY);
 }
 
 void ZoominatorController::onTick()
 {
 	const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
-	if (lastTickMs <= 0)
+	if (frameTickSeconds > 0.0 && lastTickMs > 0)
+		tickDeltaSeconds = clampd(frameTickSeconds, 1.0 / 240.0, 1.0 / 20.0);
+	else if (lastTickMs <= 0)
 		tickDeltaSeconds = 1.0 / 60.0;
 	else
 		tickDeltaSeconds = clampd((double)(nowMs - lastTickMs) / 1000.0, 1.0 / 240.0, 1.0 / 20.0);
+	frameTickSeconds = 0.0;
 	lastTickMs = nowMs;
 
+	// OBS profiler scopes only while debugging; see ZoominatorTickProfiler.
+	tickProfiler.setObsScopes(debug);
+	ZoominatorTickProfiler::Scope tickScope(tickProfiler, ZoominatorTickPhase::Tick);
+	ZoominatorStats::TickScope statsScope(stats);
+
+	if (!zoomActive && zoomMethod == "filter") {
+		ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::Capture);
+		zoomActive = ensureCameraFilter(currentMirroredScene());
+		if (!zoomActive) {
+			ensureTicking(false);
+			resetState();
+			return;
+		}
+	}
+
 	if (!zoomActive) {
+		ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::Capture);
 		std::vector<obs_sceneitem_t *> items;
-		enumerateTargetItemsInCurrentScene(items);
+		if (zoomMethod == "container") {
+			if (obs_sceneitem_t *container = ensureZoomContainer(currentMirroredScene()))
+				items.push_back(container);
+		} else {
+			enumerateTargetItemsInCurrentScene(items);
+		}
 		if (items.empty()) {
 			if (debug)
 				blog(LOG_WARNING, "[Zoominator] No movable scene items in current scene.");
@@ -2541,177 +3454,207 @@ void ZoominatorController::onTick()
 		restoringRecovery = true;
 		restoreOriginalSceneItemsFromState();
 		restoringRecovery = false;
-		clearRecoveryActive();
+		{
+			ZoominatorTickProfiler::Scope scope(tickProfiler, ZoominatorTickPhase::SettingsSave);
+			finishRecoveryActivation();
+		}
 		ensureTicking(false);
 		resetState();
 		return;
 	}
 
+	applySettled = false;
 	applyZoomToScene(animT);
+
+	static constexpr int kIdleAfterSettledTicks = 3;
+	if (applySettled && hasMotionEvents()) {
+		if (++settledTicks >= kIdleAfterSettledTicks)
+			enterIdle();
+	} else {
+		settledTicks = 0;
+	}
 }
 
 
 static ZoominatorController *g_ctl = nullptr;
 
-struct ModifierState {
-	bool leftCtrl = false;
-	bool rightCtrl = false;
-	bool leftAlt = false;
-	bool rightAlt = false;
-	bool leftShift = false;
-	bool rightShift = false;
-	bool leftWin = false;
-	bool rightWin = false;
-};
+#ifdef __linux__
+// Modifier state follows the raw key stream of the active input backend once
+// the hooks are installed, so trigger checks never make an X round trip.
+static std::atomic<uint8_t> g_inputModifiers{0};
+static std::atomic<bool> g_inputModifiersTracked{false};
 
-static inline bool family_matches(bool wantAny, bool wantLeft, bool wantRight, bool haveLeft, bool haveRight)
+static uint8_t modifier_bit(int sym)
 {
-	if (!wantAny && !wantLeft && !wantRight)
-		return !haveLeft && !haveRight;
-	if (wantLeft && !haveLeft)
-		return false;
-	if (wantRight && !haveRight)
-		return false;
-	if (!wantAny) {
-		if (!wantLeft && haveLeft)
-			return false;
-		if (!wantRight && haveRight)
-			return false;
+	switch (sym) {
+	case XK_Control_L:
+		return kZoominatorModLeftCtrl;
+	case XK_Control_R:
+		return kZoominatorModRightCtrl;
+	case XK_Alt_L:
+		return kZoominatorModLeftAlt;
+	case XK_Alt_R:
+		return kZoominatorModRightAlt;
+	case XK_Shift_L:
+		return kZoominatorModLeftShift;
+	case XK_Shift_R:
+		return kZoominatorModRightShift;
+	case XK_Super_L:
+		return kZoominatorModLeftWin;
+	case XK_Super_R:
+		return kZoominatorModRightWin;
+	default:
+		return 0;
 	}
-	return wantAny ? (haveLeft || haveRight) : true;
 }
 
-static ModifierState current_modifiers()
+static uint8_t query_x11_modifiers(Display *dpy)
+{
+	static const KeySym kModifierSyms[] = {XK_Control_L, XK_Control_R, XK_Alt_L,   XK_Alt_R,
+					       XK_Shift_L,   XK_Shift_R,   XK_Super_L, XK_Super_R};
+	char keys[32];
+	XQueryKeymap(dpy, keys);
+
+	uint8_t state = 0;
+	for (KeySym sym : kModifierSyms) {
+		KeyCode kc = XKeysymToKeycode(dpy, sym);
+		if (kc != 0 && (keys[kc / 8] & (1 << (kc % 8))) != 0)
+			state |= modifier_bit((int)sym);
+	}
+	return state;
+}
+
+static void track_input_modifier(KeySym sym, bool down)
 {
-	ModifierState state;
+	const uint8_t bit = modifier_bit((int)sym);
+	if (down)
+		g_inputModifiers.fetch_or(bit, std::memory_order_relaxed);
+	else
+		g_inputModifiers.fetch_and((uint8_t)~bit, std::memory_order_relaxed);
+}
+#endif
+
+static uint8_t current_modifiers()
+{
+	uint8_t state = 0;
 #if defined(_WIN32)
-	auto down = [](int vk) {
-		return (GetAsyncKeyState(vk) & 0x8000) != 0;
+	auto down = [&](int vk, uint8_t bit) {
+		if (GetAsyncKeyState(vk) & 0x8000)
+			state |= bit;
 	};
-	state.leftCtrl = down(VK_LCONTROL);
-	state.rightCtrl = down(VK_RCONTROL);
-	state.leftAlt = down(VK_LMENU);
-	state.rightAlt = down(VK_RMENU);
-	state.leftShift = down(VK_LSHIFT);
-	state.rightShift = down(VK_RSHIFT);
-	state.leftWin = down(VK_LWIN);
-	state.rightWin = down(VK_RWIN);
+	down(VK_LCONTROL, kZoominatorModLeftCtrl);
+	down(VK_RCONTROL, kZoominatorModRightCtrl);
+	down(VK_LMENU, kZoominatorModLeftAlt);
+	down(VK_RMENU, kZoominatorModRightAlt);
+	down(VK_LSHIFT, kZoominatorModLeftShift);
+	down(VK_RSHIFT, kZoominatorModRightShift);
+	down(VK_LWIN, kZoominatorModLeftWin);
+	down(VK_RWIN, kZoominatorModRightWin);
 #elif defined(__APPLE__)
-	auto down = [](int vk) {
-		return CGEventSourceKeyState(kCGEventSourceStateCombinedSessionState, (CGKeyCode)vk);
+	auto down = [&](int vk, uint8_t bit) {
+		if (CGEventSourceKeyState(kCGEventSourceStateCombinedSessionState, (CGKeyCode)vk))
+			state |= bit;
 	};
-	state.leftCtrl = down(kVK_Control);
-	state.rightCtrl = down(kVK_RightControl);
-	state.leftAlt = down(kVK_Option);
-	state.rightAlt = down(kVK_RightOption);
-	state.leftShift = down(kVK_Shift);
-	state.rightShift = down(kVK_RightShift);
-	state.leftWin = down(kVK_Command);
-	state.rightWin = down(kVK_RightCommand);
+	down(kVK_Control, kZoominatorModLeftCtrl);
+	down(kVK_RightControl, kZoominatorModRightCtrl);
+	down(kVK_Option, kZoominatorModLeftAlt);
+	down(kVK_RightOption, kZoominatorModRightAlt);
+	down(kVK_Shift, kZoominatorModLeftShift);
+	down(kVK_RightShift, kZoominatorModRightShift);
+	down(kVK_Command, kZoominatorModLeftWin);
+	down(kVK_RightCommand, kZoominatorModRightWin);
 #elif defined(__linux__)
-	Display *dpy = XOpenDisplay(nullptr);
-	if (dpy) {
-		char keys[32];
-		XQueryKeymap(dpy, keys);
-		auto isDown = [&](KeySym sym) -> bool {
-			KeyCode kc = XKeysymToKeycode(dpy, sym);
-			if (kc == 0)
-				return false;
-			return (keys[kc / 8] & (1 << (kc % 8))) != 0;
-		};
-		state.leftCtrl = isDown(XK_Control_L);
-		state.rightCtrl = isDown(XK_Control_R);
-		state.leftAlt = isDown(XK_Alt_L);
-		state.rightAlt = isDown(XK_Alt_R);
-		state.leftShift = isDown(XK_Shift_L);
-		state.rightShift = isDown(XK_Shift_R);
-		state.leftWin = isDown(XK_Super_L);
-		state.rightWin = isDown(XK_Super_R);
-		XCloseDisplay(dpy);
-	}
+	if (g_inputModifiersTracked.load(std::memory_order_acquire))
+		return g_inputModifiers.load(std::memory_order_relaxed);
+	// The query connection is UI-thread only and Xlib is not initialized for
+	// threads, so an input thread never falls back to it.
+	QCoreApplication *app = QCoreApplication::instance();
+	if (!app || QThread::currentThread() != app->thread())
+		return state;
+	if (Display *dpy = shared_x11_display())
+		state = query_x11_modifiers(dpy);
 #endif
 	return state;
 }
 
-static bool mods_current(bool wantCtrl, bool wantAlt, bool wantShift, bool wantWin,
-			 bool wantLeftCtrl, bool wantRightCtrl, bool wantLeftAlt, bool wantRightAlt,
-			 bool wantLeftShift, bool wantRightShift, bool wantLeftWin, bool wantRightWin)
+static inline bool key_in(const int keys[2], int code)
 {
-	const ModifierState state = current_modifiers();
-	if (!family_matches(wantCtrl, wantLeftCtrl, wantRightCtrl, state.leftCtrl, state.rightCtrl))
-		return false;
-	if (!family_matches(wantAlt, wantLeftAlt, wantRightAlt, state.leftAlt, state.rightAlt))
-		return false;
-	if (!family_matches(wantShift, wantLeftShift, wantRightShift, state.leftShift, state.rightShift))
-		return false;
-	if (!family_matches(wantWin, wantLeftWin, wantRightWin, state.leftWin, state.rightWin))
-		return false;
-	return true;
+	return code != 0 && (code == keys[0] || code == keys[1]);
 }
 
-#ifndef _WIN32
-static bool mods_current(bool wantCtrl, bool wantAlt, bool wantShift, bool wantWin)
-{
-	return mods_current(wantCtrl, wantAlt, wantShift, wantWin, false, false, false, false, false,
-			    false, false, false);
-}
-#endif
-
 #ifdef _WIN32
-static inline bool is_modifier_vk(int vk)
+static uint8_t modifier_bit(int vk)
 {
 	switch (vk) {
 	case VK_CONTROL:
+		return kZoominatorModLeftCtrl | kZoominatorModRightCtrl;
 	case VK_LCONTROL:
+		return kZoominatorModLeftCtrl;
 	case VK_RCONTROL:
+		return kZoominatorModRightCtrl;
 	case VK_MENU:
+		return kZoominatorModLeftAlt | kZoominatorModRightAlt;
 	case VK_LMENU:
+		return kZoominatorModLeftAlt;
 	case VK_RMENU:
+		return kZoominatorModRightAlt;
 	case VK_SHIFT:
+		return kZoominatorModLeftShift | kZoominatorModRightShift;
 	case VK_LSHIFT:
+		return kZoominatorModLeftShift;
 	case VK_RSHIFT:
+		return kZoominatorModRightShift;
 	case VK_LWIN:
+		return kZoominatorModLeftWin;
 	case VK_RWIN:
-		return true;
+		return kZoominatorModRightWin;
 	default:
-		return false;
+		return 0;
 	}
 }
 
-static inline bool is_wanted_modifier_vk(int vk, const ZoominatorController *ctl)
+static int key_alias(int vk)
 {
-	if (!ctl)
-		return false;
-	if ((ctl->modCtrl && (vk == VK_CONTROL || vk == VK_LCONTROL || vk == VK_RCONTROL)) ||
-	    (ctl->modLeftCtrl && vk == VK_LCONTROL) || (ctl->modRightCtrl && vk == VK_RCONTROL))
-		return true;
-	if ((ctl->modAlt && (vk == VK_MENU || vk == VK_LMENU || vk == VK_RMENU)) ||
-	    (ctl->modLeftAlt && vk == VK_LMENU) || (ctl->modRightAlt && vk == VK_RMENU))
-		return true;
-	if ((ctl->modShift && (vk == VK_SHIFT || vk == VK_LSHIFT || vk == VK_RSHIFT)) ||
-	    (ctl->modLeftShift && vk == VK_LSHIFT) || (ctl->modRightShift && vk == VK_RSHIFT))
-		return true;
-	if ((ctl->modWin && (vk == VK_LWIN || vk == VK_RWIN)) || (ctl->modLeftWin && vk == VK_LWIN) ||
-	    (ctl->modRightWin && vk == VK_RWIN))
-		return true;
-	return false;
+	if (vk >= '0' && vk <= '9')
+		return VK_NUMPAD0 + (vk - '0');
+	if (vk >= VK_NUMPAD0 && vk <= VK_NUMPAD9)
+		return '0' + (vk - VK_NUMPAD0);
+	return 0;
 }
 
-static bool vk_matches(int pressedVk, int wantVk)
+static int mouse_button_code(const QString &want)
 {
-	if (pressedVk == wantVk)
-		return true;
-
-	if (wantVk >= '0' && wantVk <= '9') {
-		const int d = wantVk - '0';
-		return pressedVk == (VK_NUMPAD0 + d);
-	}
-	if (wantVk >= VK_NUMPAD0 && wantVk <= VK_NUMPAD9) {
-		const int d = wantVk - VK_NUMPAD0;
-		return pressedVk == ('0' + d);
-	}
+	if (want == "left")
+		return 1;
+	if (want == "right")
+		return 2;
+	if (want == "middle")
+		return 3;
+	if (want == "x1")
+		return 4;
+	if (want == "x2")
+		return 5;
+	return 0;
+}
 
-	return false;
+static int win_event_button(unsigned int msg, unsigned short mouseData)
+{
+	switch (msg) {
+	case WM_LBUTTONDOWN:
+	case WM_LBUTTONUP:
+		return 1;
+	case WM_RBUTTONDOWN:
+	case WM_RBUTTONUP:
+		return 2;
+	case WM_MBUTTONDOWN:
+	case WM_MBUTTONUP:
+		return 3;
+	case WM_XBUTTONDOWN:
+	case WM_XBUTTONUP:
+		return mouseData == XBUTTON1 ? 4 : mouseData == XBUTTON2 ? 5 : 0;
+	default:
+		return 0;
+	}
 }
 
 static bool is_modifier_only_hotkey(int vk)
@@ -2745,25 +3688,21 @@ LRESULT CALLBACK ZoominatorController::kb_hook_proc(int nCode, WPARAM wParam, LP
 			return CallNextHookEx((HHOOK)g_ctl->keyboardHook, nCode, wParam, lParam);
 
 		const int vk = (int)k->vkCode;
+		const CompiledTrigger &t = g_ctl->trigger;
 
-		if (g_ctl->followToggleHkValid && down && g_ctl->followToggleHotkeyVk != 0 &&
-		    vk_matches(vk, g_ctl->followToggleHotkeyVk) &&
-		    mods_current(g_ctl->followToggleModCtrl, g_ctl->followToggleModAlt, g_ctl->followToggleModShift,
-				 g_ctl->followToggleModWin)) {
+		if (g_ctl->followToggleHkValid && down && key_in(t.followKeys, vk) &&
+		    t.followMods.matches(current_modifiers())) {
 			g_ctl->toggleFollowMouseRuntime();
 		}
 
-		if (!(g_ctl->hkValid && g_ctl->triggerType == "keyboard"))
+		if (!(g_ctl->hkValid && t.keyboard))
 			return CallNextHookEx((HHOOK)g_ctl->keyboardHook, nCode, wParam, lParam);
 
 		if (g_ctl->hotkeyVk == 0) {
-			if (!is_modifier_vk(vk))
-				return CallNextHookEx((HHOOK)g_ctl->keyboardHook, nCode, wParam, lParam);
-
-			if (!is_wanted_modifier_vk(vk, g_ctl))
+			if ((modifier_bit(vk) & t.mods.wanted) == 0)
 				return CallNextHookEx((HHOOK)g_ctl->keyboardHook, nCode, wParam, lParam);
 
-			if (g_ctl->hotkeyMode == "toggle") {
+			if (t.toggle) {
 				if (down)
 					g_ctl->onTriggerDown();
 			} else {
@@ -2776,17 +3715,15 @@ LRESULT CALLBACK ZoominatorController::kb_hook_proc(int nCode, WPARAM wParam, LP
 			return CallNextHookEx((HHOOK)g_ctl->keyboardHook, nCode, wParam, lParam);
 		}
 
-		if (vk_matches(vk, g_ctl->hotkeyVk)) {
-			if (mods_current(g_ctl->modCtrl, g_ctl->modAlt, g_ctl->modShift, g_ctl->modWin, g_ctl->modLeftCtrl, g_ctl->modRightCtrl, g_ctl->modLeftAlt, g_ctl->modRightAlt, g_ctl->modLeftShift, g_ctl->modRightShift, g_ctl->modLeftWin, g_ctl->modRightWin)) {
-				if (g_ctl->hotkeyMode == "toggle") {
-					if (down)
-						g_ctl->onTriggerDown();
-				} else {
-					if (down)
-						g_ctl->onTriggerDown();
-					if (up)
-						g_ctl->onTriggerUp();
-				}
+		if (key_in(t.keys, vk) && t.mods.matches(current_modifiers())) {
+			if (t.toggle) {
+				if (down)
+					g_ctl->onTriggerDown();
+			} else {
+				if (down)
+					g_ctl->onTriggerDown();
+				if (up)
+					g_ctl->onTriggerUp();
 			}
 		}
 	}
@@ -2805,22 +3742,25 @@ LRESULT CALLBACK ZoominatorController::mouse_hook_proc(int nCode, WPARAM wParam,
 		const bool up = (wParam == WM_LBUTTONUP || wParam == WM_RBUTTONUP || wParam == WM_MBUTTONUP ||
 				 wParam == WM_XBUTTONUP);
 
+		if (wParam == WM_MOUSEMOVE)
+			g_ctl->wakeFromIdle();
+
 		if (down)
 			g_ctl->captureMarkerClickPosition();
 
-		if (g_ctl->triggerType == "mouse" && (down || up)) {
-			unsigned short mouseData = (unsigned short)HIWORD(m->mouseData);
-			if (mods_current(g_ctl->modCtrl, g_ctl->modAlt, g_ctl->modShift, g_ctl->modWin, g_ctl->modLeftCtrl, g_ctl->modRightCtrl, g_ctl->modLeftAlt, g_ctl->modRightAlt, g_ctl->modLeftShift, g_ctl->modRightShift, g_ctl->modLeftWin, g_ctl->modRightWin)) {
-				if (g_ctl->triggerMatchesMouse((unsigned int)wParam, mouseData)) {
-					if (g_ctl->hotkeyMode == "toggle") {
-						if (down)
-							g_ctl->onTriggerDown();
-					} else {
-						if (down)
-							g_ctl->onTriggerDown();
-						if (up)
-							g_ctl->onTriggerUp();
-					}
+		const CompiledTrigger &t = g_ctl->trigger;
+		if (!t.keyboard && (down || up)) {
+			const unsigned short mouseData = (unsigned short)HIWORD(m->mouseData);
+			if (win_event_button((unsigned int)wParam, mouseData) == t.button &&
+			    t.mods.matches(current_modifiers())) {
+				if (t.toggle) {
+					if (down)
+						g_ctl->onTriggerDown();
+				} else {
+					if (down)
+						g_ctl->onTriggerDown();
+					if (up)
+						g_ctl->onTriggerUp();
 				}
 			}
 		}
@@ -2830,62 +3770,29 @@ LRESULT CALLBACK ZoominatorController::mouse_hook_proc(int nCode, WPARAM wParam,
 #endif 
 
 #ifdef __APPLE__
-static inline bool is_modifier_vk(int vk)
-{
-	return vk == kVK_Control || vk == kVK_RightControl || vk == kVK_Option || vk == kVK_RightOption ||
-	       vk == kVK_Shift || vk == kVK_RightShift || vk == kVK_Command || vk == kVK_RightCommand;
-}
-
-static inline bool is_wanted_modifier_vk(int vk, const ZoominatorController *ctl)
-{
-	if (!ctl)
-		return false;
-	if ((ctl->modCtrl && (vk == kVK_Control || vk == kVK_RightControl)) ||
-	    (ctl->modLeftCtrl && vk == kVK_Control) || (ctl->modRightCtrl && vk == kVK_RightControl))
-		return true;
-	if ((ctl->modAlt && (vk == kVK_Option || vk == kVK_RightOption)) ||
-	    (ctl->modLeftAlt && vk == kVK_Option) || (ctl->modRightAlt && vk == kVK_RightOption))
-		return true;
-	if ((ctl->modShift && (vk == kVK_Shift || vk == kVK_RightShift)) ||
-	    (ctl->modLeftShift && vk == kVK_Shift) || (ctl->modRightShift && vk == kVK_RightShift))
-		return true;
-	if ((ctl->modWin && (vk == kVK_Command || vk == kVK_RightCommand)) ||
-	    (ctl->modLeftWin && vk == kVK_Command) || (ctl->modRightWin && vk == kVK_RightCommand))
-		return true;
-	return false;
-}
-
-static bool vk_matches(int pressedVk, int wantVk)
+static int key_alias(int vk)
 {
-	if (pressedVk == wantVk)
-		return true;
-
-	if (wantVk >= kVK_ANSI_Keypad0 && wantVk <= kVK_ANSI_Keypad9) {
+	if (vk >= kVK_ANSI_Keypad0 && vk <= kVK_ANSI_Keypad9) {
 		static const int numRow[] = {kVK_ANSI_0, kVK_ANSI_1, kVK_ANSI_2, kVK_ANSI_3, kVK_ANSI_4,
 					     kVK_ANSI_5, kVK_ANSI_6, kVK_ANSI_7, kVK_ANSI_8, kVK_ANSI_9};
-		return pressedVk == numRow[wantVk - kVK_ANSI_Keypad0];
+		return numRow[vk - kVK_ANSI_Keypad0];
 	}
-	return false;
+	return 0;
 }
 
-static bool mac_mouse_button_matches(CGEventType type, int64_t buttonNumber, const QString &want)
+static int mouse_button_code(const QString &want)
 {
-	const bool isDown = (type == kCGEventLeftMouseDown || type == kCGEventRightMouseDown || type == kCGEventOtherMouseDown);
-	const bool isUp = (type == kCGEventLeftMouseUp || type == kCGEventRightMouseUp || type == kCGEventOtherMouseUp);
-	if (!isDown && !isUp)
-		return false;
-
 	if (want == "left")
-		return buttonNumber == 0;
+		return 0;
 	if (want == "right")
-		return buttonNumber == 1;
+		return 1;
 	if (want == "middle")
-		return buttonNumber == 2;
+		return 2;
 	if (want == "x1")
-		return buttonNumber == 3;
+		return 3;
 	if (want == "x2")
-		return buttonNumber == 4;
-	return false;
+		return 4;
+	return -1;
 }
 
 CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEventType type, CGEventRef event,
@@ -2902,19 +3809,19 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 		return event;
 	}
 
+	const CompiledTrigger &t = ctl->trigger;
+
 	if (type == kCGEventKeyDown || type == kCGEventKeyUp) {
 		const int keycode = (int)CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode);
 		const bool down = (type == kCGEventKeyDown);
 
-		if (ctl->followToggleHkValid && down && ctl->followToggleHotkeyVk != 0 &&
-		    vk_matches(keycode, ctl->followToggleHotkeyVk) &&
-		    mods_current(ctl->followToggleModCtrl, ctl->followToggleModAlt, ctl->followToggleModShift,
-				 ctl->followToggleModWin)) {
+		if (ctl->followToggleHkValid && down && key_in(t.followKeys, keycode) &&
+		    t.followMods.matches(current_modifiers())) {
 			ctl->toggleFollowMouseRuntime();
 		}
 	}
 
-	if (ctl->triggerType == "keyboard" && ctl->hkValid) {
+	if (t.keyboard && ctl->hkValid) {
 		if (type == kCGEventKeyDown || type == kCGEventKeyUp) {
 			const int keycode = (int)CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode);
 			const bool down = (type == kCGEventKeyDown);
@@ -2924,17 +3831,15 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 				return event;
 			}
 
-			if (vk_matches(keycode, ctl->hotkeyVk)) {
-				if (mods_current(ctl->modCtrl, ctl->modAlt, ctl->modShift, ctl->modWin, ctl->modLeftCtrl, ctl->modRightCtrl, ctl->modLeftAlt, ctl->modRightAlt, ctl->modLeftShift, ctl->modRightShift, ctl->modLeftWin, ctl->modRightWin)) {
-					if (ctl->hotkeyMode == "toggle") {
-						if (down)
-							ctl->onTriggerDown();
-					} else {
-						if (down)
-							ctl->onTriggerDown();
-						if (up)
-							ctl->onTriggerUp();
-					}
+			if (key_in(t.keys, keycode) && t.mods.matches(current_modifiers())) {
+				if (t.toggle) {
+					if (down)
+						ctl->onTriggerDown();
+				} else {
+					if (down)
+						ctl->onTriggerDown();
+					if (up)
+						ctl->onTriggerUp();
 				}
 			}
 			return event;
@@ -2942,9 +3847,8 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 
 		if (type == kCGEventFlagsChanged) {
 			if (ctl->hotkeyVk == 0) {
-				const bool matchNow =
-					mods_current(ctl->modCtrl, ctl->modAlt, ctl->modShift, ctl->modWin, ctl->modLeftCtrl, ctl->modRightCtrl, ctl->modLeftAlt, ctl->modRightAlt, ctl->modLeftShift, ctl->modRightShift, ctl->modLeftWin, ctl->modRightWin);
-				if (ctl->hotkeyMode == "toggle") {
+				const bool matchNow = t.mods.matches(current_modifiers());
+				if (t.toggle) {
 					if (matchNow && !ctl->zoomPressed && !ctl->zoomLatched)
 						ctl->onTriggerDown();
 					else if (matchNow && ctl->zoomLatched)
@@ -2960,6 +3864,12 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 		}
 	}
 
+	if (type == kCGEventMouseMoved || type == kCGEventLeftMouseDragged || type == kCGEventRightMouseDragged ||
+	    type == kCGEventOtherMouseDragged) {
+		ctl->wakeFromIdle();
+		return event;
+	}
+
 	const bool isMouseDown = (type == kCGEventLeftMouseDown || type == kCGEventRightMouseDown ||
 				type == kCGEventOtherMouseDown);
 	const bool isMouseUp = (type == kCGEventLeftMouseUp || type == kCGEventRightMouseUp ||
@@ -2968,21 +3878,17 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 	if (isMouseDown)
 		ctl->captureMarkerClickPosition();
 
-	if (ctl->triggerType == "mouse") {
-		if (isMouseDown || isMouseUp) {
-			const int64_t btn = CGEventGetIntegerValueField(event, kCGMouseEventButtonNumber);
-			if (mods_current(ctl->modCtrl, ctl->modAlt, ctl->modShift, ctl->modWin, ctl->modLeftCtrl, ctl->modRightCtrl, ctl->modLeftAlt, ctl->modRightAlt, ctl->modLeftShift, ctl->modRightShift, ctl->modLeftWin, ctl->modRightWin)) {
-				if (mac_mouse_button_matches(type, btn, ctl->mouseButton)) {
-					if (ctl->hotkeyMode == "toggle") {
-						if (isMouseDown)
-							ctl->onTriggerDown();
-					} else {
-						if (isMouseDown)
-							ctl->onTriggerDown();
-						if (isMouseUp)
-							ctl->onTriggerUp();
-					}
-				}
+	if (!t.keyboard && (isMouseDown || isMouseUp)) {
+		const int64_t btn = CGEventGetIntegerValueField(event, kCGMouseEventButtonNumber);
+		if (btn == t.button && t.mods.matches(current_modifiers())) {
+			if (t.toggle) {
+				if (isMouseDown)
+					ctl->onTriggerDown();
+			} else {
+				if (isMouseDown)
+					ctl->onTriggerDown();
+				if (isMouseUp)
+					ctl->onTriggerUp();
 			}
 		}
 	}
@@ -2992,62 +3898,358 @@ CGEventRef ZoominatorController::eventTapCallback(CGEventTapProxy proxy, CGEvent
 #endif 
 
 #ifdef __linux__
-static inline bool is_modifier_vk(int vk)
+static int key_alias(int vk)
 {
-	return vk == XK_Control_L || vk == XK_Control_R || vk == XK_Alt_L || vk == XK_Alt_R || vk == XK_Shift_L ||
-	       vk == XK_Shift_R || vk == XK_Super_L || vk == XK_Super_R;
+	if (vk >= XK_a && vk <= XK_z)
+		return vk - XK_a + XK_A;
+	if (vk >= XK_A && vk <= XK_Z)
+		return vk - XK_A + XK_a;
+	if (vk >= XK_KP_0 && vk <= XK_KP_9)
+		return XK_0 + (vk - XK_KP_0);
+	if (vk >= XK_0 && vk <= XK_9)
+		return XK_KP_0 + (vk - XK_0);
+	return 0;
 }
 
-static inline bool is_wanted_modifier_vk(int vk, const ZoominatorController *ctl)
+static int mouse_button_code(const QString &want)
 {
-	if (!ctl)
+	if (want == "left")
+		return 1;
+	if (want == "middle")
+		return 2;
+	if (want == "right")
+		return 3;
+	if (want == "x1")
+		return 8;
+	if (want == "x2")
+		return 9;
+	return 0;
+}
+
+static bool xi_device_is_absolute(Display *dpy, int deviceId)
+{
+	int count = 0;
+	XIDeviceInfo *info = XIQueryDevice(dpy, deviceId, &count);
+	if (!info)
 		return false;
-	if ((ctl->modCtrl && (vk == XK_Control_L || vk == XK_Control_R)) ||
-	    (ctl->modLeftCtrl && vk == XK_Control_L) || (ctl->modRightCtrl && vk == XK_Control_R))
-		return true;
-	if ((ctl->modAlt && (vk == XK_Alt_L || vk == XK_Alt_R)) ||
-	    (ctl->modLeftAlt && vk == XK_Alt_L) || (ctl->modRightAlt && vk == XK_Alt_R))
-		return true;
-	if ((ctl->modShift && (vk == XK_Shift_L || vk == XK_Shift_R)) ||
-	    (ctl->modLeftShift && vk == XK_Shift_L) || (ctl->modRightShift && vk == XK_Shift_R))
-		return true;
-	if ((ctl->modWin && (vk == XK_Super_L || vk == XK_Super_R)) ||
-	    (ctl->modLeftWin && vk == XK_Super_L) || (ctl->modRightWin && vk == XK_Super_R))
-		return true;
-	return false;
+
+	bool absolute = false;
+	for (int i = 0; i < count && !absolute; i++) {
+		for (int c = 0; c < info[i].num_classes; c++) {
+			const XIAnyClassInfo *cls = info[i].classes[c];
+			if (!cls || cls->type != XIValuatorClass)
+				continue;
+			const auto *v = reinterpret_cast<const XIValuatorClassInfo *>(cls);
+			if ((v->number == 0 || v->number == 1) && v->mode == XIModeAbsolute) {
+				absolute = true;
+				break;
+			}
+		}
+	}
+
+	XIFreeDeviceInfo(info);
+	return absolute;
 }
 
-static bool vk_matches(int pressedVk, int wantVk)
+static bool xi_raw_motion_delta(const XIRawEvent *raw, double &dx, double &dy)
 {
-	if (pressedVk == wantVk)
-		return true;
+	dx = 0.0;
+	dy = 0.0;
+	bool any = false;
+	const double *values = raw->valuators.values;
+	const int bits = raw->valuators.mask_len * 8;
+	for (int bit = 0, idx = 0; bit < bits && bit <= 1; bit++) {
+		if (!XIMaskIsSet(raw->valuators.mask, bit))
+			continue;
+		if (bit == 0)
+			dx = values[idx];
+		else
+			dy = values[idx];
+		idx++;
+		any = true;
+	}
+	return any;
+}
+
+bool ZoominatorController::resyncXInput2Cursor(uint64_t nowNs)
+{
+	if (!xiDisplay)
+		return false;
+
+	Window root = 0, child = 0;
+	int rootX = 0, rootY = 0, winX = 0, winY = 0;
+	unsigned int mask = 0;
+	if (!XQueryPointer(xiDisplay, DefaultRootWindow(xiDisplay), &root, &child, &rootX, &rootY, &winX, &winY,
+			   &mask)) {
+		inputCursorValid = false;
+		return false;
+	}
 
-	if (wantVk >= XK_a && wantVk <= XK_z)
-		return pressedVk == (wantVk - XK_a + XK_A);
-	if (wantVk >= XK_A && wantVk <= XK_Z)
-		return pressedVk == (wantVk - XK_A + XK_a);
+	inputCursorX = rootX;
+	inputCursorY = rootY;
+	xiCursorSyncNs = nowNs;
+	inputCursorValid = true;
+	return true;
+}
 
-	if (wantVk >= XK_KP_0 && wantVk <= XK_KP_9)
-		return pressedVk == (XK_0 + (wantVk - XK_KP_0));
-	if (wantVk >= XK_0 && wantVk <= XK_9)
-		return pressedVk == (XK_KP_0 + (wantVk - XK_0));
+void ZoominatorController::xiThreadMain()
+{
+	pollfd fds[2] = {};
+	fds[0].fd = ConnectionNumber(xiDisplay);
+	fds[0].events = POLLIN;
+	fds[1].fd = xiWakeFd;
+	fds[1].events = POLLIN;
+
+	// Xlib may already hold queued events that poll() cannot see, so the queue
+	// is drained before every wait.
+	while (!xiStop.load(std::memory_order_acquire)) {
+		processXInput2Events();
+		if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+			blog(LOG_WARNING, "[Zoominator] Input thread poll failed (errno %d); stopping.", errno);
+			break;
+		}
+	}
+}
 
-	return false;
+uint64_t ZoominatorController::xiEventTimeNs(unsigned long serverMs)
+{
+	// X server timestamps are milliseconds on an unrelated clock; track the
+	// smallest local-minus-server offset (the least delayed event) to map them.
+	const int64_t serverNs = (int64_t)serverMs * 1000000;
+	const int64_t offsetNs = (int64_t)os_gettime_ns() - serverNs;
+	if (!xiTimeOffsetValid || offsetNs < xiTimeOffsetNs || offsetNs - xiTimeOffsetNs > 1000000000) {
+		xiTimeOffsetNs = offsetNs;
+		xiTimeOffsetValid = true;
+	}
+	return (uint64_t)(serverNs + xiTimeOffsetNs);
 }
 
-static bool linux_button_matches(int button, const QString &want)
+void ZoominatorController::postInputEvent(InputEventKind kind, uint64_t tNs, int x, int y)
 {
-	if (want == "left")
-		return button == 1;
-	if (want == "middle")
-		return button == 2;
-	if (want == "right")
-		return button == 3;
-	if (want == "x1")
-		return button == 8;
-	if (want == "x2")
-		return button == 9;
-	return false;
+	InputEvent ev;
+	ev.tNs = tNs;
+	ev.kind = kind;
+	ev.x = x;
+	ev.y = y;
+
+	// Clicks only flash a halo and are dropped when the ring is full. Trigger
+	// edges never are: they, and every edge after them until the overflow has
+	// been delivered, go through the event loop instead, which queues them
+	// behind the drain that empties the ring and so keeps them in order.
+	const bool click = kind == InputEventKind::Click;
+	if (click || inputOverflowEdges.load(std::memory_order_acquire) == 0) {
+		if (inputEvents.push(ev)) {
+			// One queued drain covers every event pushed before it runs.
+			if (!inputDrainPending.exchange(true, std::memory_order_acq_rel))
+				QMetaObject::invokeMethod(this, [this]() { drainInputEvents(); }, Qt::QueuedConnection);
+			return;
+		}
+		if (click) {
+			inputDroppedClicks.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	inputOverflowEdges.fetch_add(1, std::memory_order_acq_rel);
+	QMetaObject::invokeMethod(
+		this,
+		[this, ev]() {
+			inputOverflowEdges.fetch_sub(1, std::memory_order_acq_rel);
+			if (shuttingDown)
+				return;
+			logi(debug, "[Zoominator] Input queue full; delivered event %d through the event loop",
+			     (int)ev.kind);
+			dispatchInputEvent(ev);
+		},
+		Qt::QueuedConnection);
+}
+
+void ZoominatorController::drainInputEvents()
+{
+	inputDrainPending.store(false, std::memory_order_release);
+	if (shuttingDown)
+		return;
+
+	InputEvent ev;
+	while (inputEvents.pop(ev))
+		dispatchInputEvent(ev);
+
+	if (const uint64_t dropped = inputDroppedClicks.exchange(0, std::memory_order_relaxed))
+		logi(debug, "[Zoominator] Input queue full; dropped %llu click(s)", (unsigned long long)dropped);
+}
+
+void ZoominatorController::dispatchInputEvent(const InputEvent &ev)
+{
+	if (debug && ev.kind != InputEventKind::Click) {
+		const uint64_t nowNs = os_gettime_ns();
+		logi(debug, "[Zoominator] Input event %d dispatched %.2f ms after it occurred", (int)ev.kind,
+		     nowNs > ev.tNs ? (double)(nowNs - ev.tNs) / 1000000.0 : 0.0);
+	}
+
+	switch (ev.kind) {
+	case InputEventKind::TriggerDown:
+		onTriggerDown();
+		break;
+	case InputEventKind::TriggerUp:
+		onTriggerUp();
+		break;
+	case InputEventKind::TriggerRelease:
+		if (zoomPressed)
+			onTriggerUp();
+		break;
+	case InputEventKind::FollowToggle:
+		toggleFollowMouseRuntime();
+		break;
+	case InputEventKind::Click:
+		captureMarkerClickAt(ev.x, ev.y);
+		break;
+	}
+}
+
+const ZoominatorController::CompiledTrigger &ZoominatorController::refreshInputTrigger()
+{
+	const uint64_t gen = inputTriggerGen.load(std::memory_order_acquire);
+	if (gen != inputTriggerSeen) {
+		std::lock_guard<std::mutex> guard(inputTriggerLock);
+		inputTrigger = inputPendingTrigger;
+		inputTriggerSeen = gen;
+	}
+	return inputTrigger;
+}
+
+void ZoominatorController::matchInputKey(const CompiledTrigger &t, int sym, bool down, uint64_t tNs)
+{
+	track_input_modifier((KeySym)sym, down);
+
+	if (t.followEnabled && down && key_in(t.followKeys, sym) && t.followMods.matches(current_modifiers()))
+		postInputEvent(InputEventKind::FollowToggle, tNs);
+
+	if (!t.enabled || !t.keyboard)
+		return;
+
+	if (t.modifierOnly) {
+		if ((modifier_bit(sym) & t.mods.wanted) == 0)
+			return;
+		const bool matchNow = t.mods.matches(current_modifiers());
+		if (down && matchNow)
+			postInputEvent(InputEventKind::TriggerDown, tNs);
+		else if (!down && !matchNow && !t.toggle)
+			postInputEvent(InputEventKind::TriggerRelease, tNs);
+	} else if (key_in(t.keys, sym) && t.mods.matches(current_modifiers())) {
+		if (down)
+			postInputEvent(InputEventKind::TriggerDown, tNs);
+		else if (!t.toggle)
+			postInputEvent(InputEventKind::TriggerUp, tNs);
+	}
+}
+
+void ZoominatorController::matchInputButton(const CompiledTrigger &t, int button, bool down, uint64_t tNs)
+{
+	if (down && t.clicks && inputCursorValid) {
+		int x = 0, y = 0;
+		mapInputCursor(x, y);
+		postInputEvent(InputEventKind::Click, tNs, x, y);
+	}
+
+	// Wheel buttons never trigger.
+	if (button >= 4 && button <= 7)
+		return;
+
+	if (!t.keyboard && button == t.button && t.mods.matches(current_modifiers())) {
+		if (down)
+			postInputEvent(InputEventKind::TriggerDown, tNs);
+		else if (!t.toggle)
+			postInputEvent(InputEventKind::TriggerUp, tNs);
+	}
+}
+
+void ZoominatorController::moveInputCursor(double dx, double dy, uint64_t tNs)
+{
+	inputCursorX = clampd(inputCursorX + dx, (double)inputBoundsX,
+			      (double)(inputBoundsX + std::max(0, inputBoundsWidth - 1)));
+	inputCursorY = clampd(inputCursorY + dy, (double)inputBoundsY,
+			      (double)(inputBoundsY + std::max(0, inputBoundsHeight - 1)));
+	int x = 0, y = 0;
+	mapInputCursor(x, y);
+	publishCursorSample(x, y, tNs);
+}
+
+void ZoominatorController::updateInputScreens()
+{
+	std::vector<InputScreen> screens;
+	const QScreen *primary = QGuiApplication::primaryScreen();
+	for (const QScreen *screen : QGuiApplication::screens()) {
+		const QRect g = screen->geometry();
+		const qreal dpr = screen->devicePixelRatio();
+		InputScreen s;
+		s.x = g.x();
+		s.y = g.y();
+		s.nativeWidth = (int)std::lround(g.width() * dpr);
+		s.nativeHeight = (int)std::lround(g.height() * dpr);
+		s.scale = dpr > 0.0 ? 1.0 / dpr : 1.0;
+		if (screen == primary)
+			screens.insert(screens.begin(), s);
+		else
+			screens.push_back(s);
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(inputScreensLock);
+		inputPendingScreens = std::move(screens);
+	}
+	inputScreensGen.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void ZoominatorController::mapInputCursor(int &x, int &y)
+{
+	const uint64_t gen = inputScreensGen.load(std::memory_order_acquire);
+	if (gen != inputScreensSeen) {
+		std::lock_guard<std::mutex> guard(inputScreensLock);
+		inputScreens = inputPendingScreens;
+		inputScreensSeen = gen;
+	}
+
+	const InputScreen *screen = nullptr;
+	if (inputCursorNative) {
+		for (const InputScreen &s : inputScreens) {
+			if (inputCursorX >= s.x && inputCursorX < s.x + s.nativeWidth && inputCursorY >= s.y &&
+			    inputCursorY < s.y + s.nativeHeight) {
+				screen = &s;
+				break;
+			}
+		}
+		if (!screen && !inputScreens.empty())
+			screen = &inputScreens.front();
+	}
+
+	if (!screen) {
+		x = (int)std::lround(inputCursorX);
+		y = (int)std::lround(inputCursorY);
+		return;
+	}
+	x = (int)std::lround(screen->x + (inputCursorX - screen->x) * screen->scale);
+	y = (int)std::lround(screen->y + (inputCursorY - screen->y) * screen->scale);
+}
+
+void ZoominatorController::evdevEvent(const ZoominatorEvdevInput::Event &ev, void *param)
+{
+	auto *ctl = static_cast<ZoominatorController *>(param);
+	switch (ev.type) {
+	case ZoominatorEvdevInput::EventType::Key:
+		// Keys held at startup only seed the modifier state.
+		if (ev.held)
+			track_input_modifier((KeySym)ev.code, true);
+		else
+			ctl->matchInputKey(ctl->refreshInputTrigger(), ev.code, ev.down, ev.tNs);
+		break;
+	case ZoominatorEvdevInput::EventType::Button:
+		ctl->matchInputButton(ctl->refreshInputTrigger(), ev.code, ev.down, ev.tNs);
+		break;
+	case ZoominatorEvdevInput::EventType::Motion:
+		if (ctl->inputCursorValid)
+			ctl->moveInputCursor(ev.dx, ev.dy, ev.tNs);
+		break;
+	}
 }
 
 void ZoominatorController::processXInput2Events()
@@ -3055,6 +4257,8 @@ void ZoominatorController::processXInput2Events()
 	if (!xiDisplay)
 		return;
 
+	const CompiledTrigger &t = refreshInputTrigger();
+
 	while (XPending(xiDisplay)) {
 		XEvent ev;
 		XNextEvent(xiDisplay, &ev);
@@ -3070,72 +4274,39 @@ void ZoominatorController::processXInput2Events()
 			XIRawEvent *raw = (XIRawEvent *)ev.xcookie.data;
 			const int keycode = raw->detail;
 			KeySym sym = XkbKeycodeToKeysym(xiDisplay, keycode, 0, 0);
-			const bool down = (evtype == XI_RawKeyPress);
-
-			if (followToggleHkValid && down && followToggleHotkeyVk != 0 &&
-			    vk_matches((int)sym, followToggleHotkeyVk) &&
-			    mods_current(followToggleModCtrl, followToggleModAlt, followToggleModShift,
-					 followToggleModWin)) {
-				toggleFollowMouseRuntime();
+			matchInputKey(t, (int)sym, evtype == XI_RawKeyPress, xiEventTimeNs(raw->time));
+		} else if (evtype == XI_RawMotion) {
+			// Relative devices are integrated locally from raw deltas; absolute ones
+			// (tablets, VM pointers) and periodic drift correction use XQueryPointer.
+			static constexpr uint64_t kCursorResyncNs = 250000000;
+			XIRawEvent *raw = (XIRawEvent *)ev.xcookie.data;
+			const uint64_t localNs = os_gettime_ns();
+			const uint64_t sampleNs = xiEventTimeNs(raw->time);
+
+			auto absIt = xiAbsoluteDevices.constFind(raw->sourceid);
+			bool absolute = false;
+			if (absIt == xiAbsoluteDevices.constEnd()) {
+				absolute = xi_device_is_absolute(xiDisplay, raw->sourceid);
+				xiAbsoluteDevices.insert(raw->sourceid, absolute);
+			} else {
+				absolute = absIt.value();
 			}
 
-			if (hkValid && triggerType == "keyboard") {
-				if (hotkeyVk == 0) {
-					if (is_modifier_vk((int)sym) && is_wanted_modifier_vk((int)sym, this)) {
-						const bool matchNow = mods_current(modCtrl, modAlt, modShift, modWin, modLeftCtrl, modRightCtrl, modLeftAlt, modRightAlt, modLeftShift, modRightShift, modLeftWin, modRightWin);
-						if (hotkeyMode == "toggle") {
-							if (down && matchNow)
-								onTriggerDown();
-						} else {
-							if (down && matchNow)
-								onTriggerDown();
-							if (!down && zoomPressed && !matchNow)
-								onTriggerUp();
-						}
-					}
-				} else if (vk_matches((int)sym, hotkeyVk)) {
-					if (mods_current(modCtrl, modAlt, modShift, modWin, modLeftCtrl, modRightCtrl, modLeftAlt, modRightAlt, modLeftShift, modRightShift, modLeftWin, modRightWin)) {
-						if (hotkeyMode == "toggle") {
-							if (down)
-								onTriggerDown();
-						} else {
-							if (down)
-								onTriggerDown();
-							if (!down)
-								onTriggerUp();
-						}
-					}
-				}
+			double dx = 0.0, dy = 0.0;
+			const bool haveDelta = !absolute && xi_raw_motion_delta(raw, dx, dy);
+			if (!inputCursorValid || !haveDelta || localNs - xiCursorSyncNs > kCursorResyncNs) {
+				resyncXInput2Cursor(localNs);
+				dx = 0.0;
+				dy = 0.0;
 			}
+
+			if (inputCursorValid)
+				moveInputCursor(dx, dy, sampleNs);
+		} else if (evtype == XI_HierarchyChanged) {
+			xiAbsoluteDevices.clear();
 		} else if (evtype == XI_RawButtonPress || evtype == XI_RawButtonRelease) {
 			XIRawEvent *raw = (XIRawEvent *)ev.xcookie.data;
-			const int button = raw->detail;
-			const bool down = (evtype == XI_RawButtonPress);
-			const bool up = (evtype == XI_RawButtonRelease);
-
-			if (down)
-				captureMarkerClickPosition();
-
-			if (button >= 4 && button <= 7) {
-				XFreeEventData(xiDisplay, &ev.xcookie);
-				continue;
-			}
-
-			if (triggerType == "mouse" && (down || up)) {
-				if (mods_current(modCtrl, modAlt, modShift, modWin, modLeftCtrl, modRightCtrl, modLeftAlt, modRightAlt, modLeftShift, modRightShift, modLeftWin, modRightWin)) {
-					if (linux_button_matches(button, mouseButton)) {
-						if (hotkeyMode == "toggle") {
-							if (down)
-								onTriggerDown();
-						} else {
-							if (down)
-								onTriggerDown();
-							if (up)
-								onTriggerUp();
-						}
-					}
-				}
-			}
+			matchInputButton(t, raw->detail, evtype == XI_RawButtonPress, xiEventTimeNs(raw->time));
 		}
 
 		XFreeEventData(xiDisplay, &ev.xcookie);
@@ -3143,29 +4314,52 @@ void ZoominatorController::processXInput2Events()
 }
 #endif 
 
+void ZoominatorController::compileTrigger()
+{
+	CompiledTrigger t;
+	t.enabled = hkValid;
+	t.keyboard = triggerType != "mouse";
+	t.toggle = hotkeyMode == "toggle";
+	t.modifierOnly = hotkeyVk == 0;
+	t.clicks = showCursorMarker && markerOnlyOnClick;
+	t.followEnabled = followToggleHkValid;
+	t.keys[0] = hotkeyVk;
+	t.keys[1] = hotkeyVk ? key_alias(hotkeyVk) : 0;
+	t.mods.want(kZoominatorModCtrl, modCtrl, modLeftCtrl, modRightCtrl);
+	t.mods.want(kZoominatorModAlt, modAlt, modLeftAlt, modRightAlt);
+	t.mods.want(kZoominatorModShift, modShift, modLeftShift, modRightShift);
+	t.mods.want(kZoominatorModWin, modWin, modLeftWin, modRightWin);
+	t.button = mouse_button_code(mouseButton);
+
+	t.followKeys[0] = followToggleHotkeyVk;
+	t.followKeys[1] = followToggleHotkeyVk ? key_alias(followToggleHotkeyVk) : 0;
+	t.followMods.want(kZoominatorModCtrl, followToggleModCtrl, false, false);
+	t.followMods.want(kZoominatorModAlt, followToggleModAlt, false, false);
+	t.followMods.want(kZoominatorModShift, followToggleModShift, false, false);
+	t.followMods.want(kZoominatorModWin, followToggleModWin, false, false);
+	trigger = t;
+
+#ifdef __linux__
+	{
+		std::lock_guard<std::mutex> guard(inputTriggerLock);
+		inputPendingTrigger = t;
+	}
+	inputTriggerGen.fetch_add(1, std::memory_order_acq_rel);
+#endif
+}
+
 bool ZoominatorController::modsMatch() const
 {
-	return mods_current(modCtrl, modAlt, modShift, modWin, modLeftCtrl, modRightCtrl, modLeftAlt, modRightAlt, modLeftShift, modRightShift, modLeftWin, modRightWin);
+	return trigger.mods.matches(current_modifiers());
 }
 
 bool ZoominatorController::triggerMatchesMouse(unsigned int msg, unsigned short mouseData) const
 {
 #ifdef _WIN32
-	const QString b = mouseButton;
-	if (b == "left")
-		return msg == WM_LBUTTONDOWN || msg == WM_LBUTTONUP;
-	if (b == "right")
-		return msg == WM_RBUTTONDOWN || msg == WM_RBUTTONUP;
-	if (b == "middle")
-		return msg == WM_MBUTTONDOWN || msg == WM_MBUTTONUP;
-	if (b == "x1")
-		return (msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP) && mouseData == XBUTTON1;
-	if (b == "x2")
-		return (msg == WM_XBUTTONDOWN || msg == WM_XBUTTONUP) && mouseData == XBUTTON2;
-	return false;
+	return win_event_button(msg, mouseData) == trigger.button;
 #elif defined(__linux__)
 	(void)mouseData;
-	return linux_button_matches((int)msg, mouseButton);
+	return (int)msg == trigger.button;
 #else
 	(void)msg;
 	(void)mouseData;
@@ -3178,7 +4372,7 @@ void ZoominatorController::onTriggerDown()
 	if (debug)
 		blog(LOG_INFO, "[Zoominator] Trigger DOWN");
 
-	if (hotkeyMode == "toggle") {
+	if (trigger.toggle) {
 		zoomLatched = !zoomLatched;
 		if (zoomLatched) {
 			followHasPos = false;
@@ -3206,6 +4400,7 @@ void ZoominatorController::onTriggerUp()
 
 void ZoominatorController::toggleFollowMouseRuntime()
 {
+	wakeFromIdle();
 	followMouseRuntimeEnabled = !followMouseRuntimeEnabled;
 	if (!followMouseRuntimeEnabled && followHasPos) {
 		targetX = followX;
@@ -3682,6 +4877,8 @@ void ZoominatorController::rebuildTriggersFromSettings()
 	} else {
 		hkValid = true;
 	}
+
+	compileTrigger();
 }
 
 void ZoominatorController::installHooks()
@@ -3703,7 +4900,9 @@ void ZoominatorController::installHooks()
 				   CGEventMaskBit(kCGEventFlagsChanged) | CGEventMaskBit(kCGEventLeftMouseDown) |
 				   CGEventMaskBit(kCGEventLeftMouseUp) | CGEventMaskBit(kCGEventRightMouseDown) |
 				   CGEventMaskBit(kCGEventRightMouseUp) | CGEventMaskBit(kCGEventOtherMouseDown) |
-				   CGEventMaskBit(kCGEventOtherMouseUp);
+				   CGEventMaskBit(kCGEventOtherMouseUp) | CGEventMaskBit(kCGEventMouseMoved) |
+				   CGEventMaskBit(kCGEventLeftMouseDragged) | CGEventMaskBit(kCGEventRightMouseDragged) |
+				   CGEventMaskBit(kCGEventOtherMouseDragged);
 		eventTap = CGEventTapCreate(kCGSessionEventTap, kCGHeadInsertEventTap, kCGEventTapOptionListenOnly, mask,
 					    eventTapCallback, this);
 		if (eventTap) {
@@ -3719,49 +4918,134 @@ void ZoominatorController::installHooks()
 #elif defined(__linux__)
 	g_ctl = this;
 
+	if (xiDisplay || evdevInput.running())
+		return;
+
+	// XInput2 only sees XWayland clients under Wayland, so "auto" reads evdev
+	// there and falls back to it when no usable X server is reachable.
+	const bool wayland = qEnvironmentVariable("XDG_SESSION_TYPE") == QStringLiteral("wayland") ||
+			     qEnvironmentVariableIsSet("WAYLAND_DISPLAY");
+	const bool preferEvdev = inputBackend == "evdev" || (inputBackend == "auto" && wayland);
+	installedInputBackend = inputBackend;
+	if (preferEvdev && installEvdevHooks())
+		return;
+	if (installXInput2Hooks())
+		return;
+	if (!preferEvdev && inputBackend == "auto")
+		installEvdevHooks();
+#endif
+}
+
+#ifdef __linux__
+bool ZoominatorController::installXInput2Hooks()
+{
+	xiDisplay = XOpenDisplay(nullptr);
 	if (!xiDisplay) {
-		xiDisplay = XOpenDisplay(nullptr);
-		if (!xiDisplay) {
-			blog(LOG_WARNING, "[Zoominator] Failed to open X11 display for input hooks.");
-			return;
-		}
+		blog(LOG_WARNING, "[Zoominator] Failed to open X11 display for input hooks.");
+		return false;
+	}
 
-		int event, error;
-		if (!XQueryExtension(xiDisplay, "XInputExtension", &xiOpcode, &event, &error)) {
-			blog(LOG_WARNING, "[Zoominator] XInput2 extension not available.");
-			XCloseDisplay(xiDisplay);
-			xiDisplay = nullptr;
-			return;
-		}
+	int event, error;
+	if (!XQueryExtension(xiDisplay, "XInputExtension", &xiOpcode, &event, &error)) {
+		blog(LOG_WARNING, "[Zoominator] XInput2 extension not available.");
+		XCloseDisplay(xiDisplay);
+		xiDisplay = nullptr;
+		return false;
+	}
 
-		int major = 2, minor = 0;
-		if (XIQueryVersion(xiDisplay, &major, &minor) != Success) {
-			blog(LOG_WARNING, "[Zoominator] XInput2 version query failed.");
-			XCloseDisplay(xiDisplay);
-			xiDisplay = nullptr;
-			return;
-		}
+	int major = 2, minor = 0;
+	if (XIQueryVersion(xiDisplay, &major, &minor) != Success) {
+		blog(LOG_WARNING, "[Zoominator] XInput2 version query failed.");
+		XCloseDisplay(xiDisplay);
+		xiDisplay = nullptr;
+		return false;
+	}
+
+	unsigned char mask_bits[(XI_LASTEVENT + 7) / 8] = {};
+	XIEventMask evmask;
+	evmask.deviceid = XIAllMasterDevices;
+	evmask.mask_len = sizeof(mask_bits);
+	evmask.mask = mask_bits;
+	XISetMask(mask_bits, XI_RawKeyPress);
+	XISetMask(mask_bits, XI_RawKeyRelease);
+	XISetMask(mask_bits, XI_RawButtonPress);
+	XISetMask(mask_bits, XI_RawButtonRelease);
+	XISetMask(mask_bits, XI_RawMotion);
+
+	unsigned char hierarchy_bits[(XI_LASTEVENT + 7) / 8] = {};
+	XISetMask(hierarchy_bits, XI_HierarchyChanged);
+
+	XIEventMask evmasks[2] = {evmask, {}};
+	evmasks[1].deviceid = XIAllDevices;
+	evmasks[1].mask_len = sizeof(hierarchy_bits);
+	evmasks[1].mask = hierarchy_bits;
+	XISelectEvents(xiDisplay, DefaultRootWindow(xiDisplay), evmasks, 2);
+	XFlush(xiDisplay);
+
+	g_inputModifiers.store(query_x11_modifiers(xiDisplay), std::memory_order_relaxed);
+	g_inputModifiersTracked.store(true, std::memory_order_release);
+
+	const int screen = DefaultScreen(xiDisplay);
+	inputBoundsX = 0;
+	inputBoundsY = 0;
+	inputBoundsWidth = DisplayWidth(xiDisplay, screen);
+	inputBoundsHeight = DisplayHeight(xiDisplay, screen);
+	inputCursorNative = true;
+	updateInputScreens();
+	if (resyncXInput2Cursor(os_gettime_ns())) {
+		int x = 0, y = 0;
+		mapInputCursor(x, y);
+		publishCursorSample(x, y, os_gettime_ns());
+	}
+
+	xiWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (xiWakeFd < 0) {
+		blog(LOG_WARNING, "[Zoominator] Failed to create input thread wake fd (errno %d).", errno);
+		g_inputModifiersTracked.store(false, std::memory_order_release);
+		XCloseDisplay(xiDisplay);
+		xiDisplay = nullptr;
+		return false;
+	}
 
-		unsigned char mask_bits[(XI_LASTEVENT + 7) / 8] = {};
-		XIEventMask evmask;
-		evmask.deviceid = XIAllMasterDevices;
-		evmask.mask_len = sizeof(mask_bits);
-		evmask.mask = mask_bits;
-		XISetMask(mask_bits, XI_RawKeyPress);
-		XISetMask(mask_bits, XI_RawKeyRelease);
-		XISetMask(mask_bits, XI_RawButtonPress);
-		XISetMask(mask_bits, XI_RawButtonRelease);
-		XISelectEvents(xiDisplay, DefaultRootWindow(xiDisplay), &evmask, 1);
-		XFlush(xiDisplay);
+	// The display is handed to the input thread here and only touched by it
+	// until uninstallHooks() joins the thread.
+	xiStop.store(false, std::memory_order_release);
+	xiThread = std::thread(&ZoominatorController::xiThreadMain, this);
 
-		int fd = ConnectionNumber(xiDisplay);
-		xiNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
-		connect(xiNotifier, &QSocketNotifier::activated, this, &ZoominatorController::processXInput2Events);
+	blog(LOG_INFO, "[Zoominator] XInput2 global input hooks installed on input thread (XI %d.%d).", major, minor);
+	return true;
+}
 
-		blog(LOG_INFO, "[Zoominator] XInput2 global input hooks installed (XI %d.%d).", major, minor);
+bool ZoominatorController::installEvdevHooks()
+{
+	const QScreen *primary = QGuiApplication::primaryScreen();
+	const QRect bounds = primary ? primary->virtualGeometry() : QRect();
+	inputBoundsX = bounds.x();
+	inputBoundsY = bounds.y();
+	inputBoundsWidth = bounds.width();
+	inputBoundsHeight = bounds.height();
+	inputCursorNative = false;
+
+	// Relative motion is integrated from wherever Qt last saw the pointer; the
+	// compositor's acceleration is not applied, so this is an approximation.
+	const QPoint start = QCursor::pos();
+	inputCursorX = start.x();
+	inputCursorY = start.y();
+	inputCursorValid = true;
+	publishCursorSample(start.x(), start.y(), os_gettime_ns());
+
+	// Tracking is on before the reader thread starts, so its first event
+	// already reads the tracked state instead of querying X.
+	g_inputModifiers.store(0, std::memory_order_relaxed);
+	g_inputModifiersTracked.store(true, std::memory_order_release);
+	if (!evdevInput.start(evdevEvent, this)) {
+		g_inputModifiersTracked.store(false, std::memory_order_release);
+		inputCursorValid = false;
+		return false;
 	}
-#endif
+	return true;
 }
+#endif
 
 void ZoominatorController::uninstallHooks()
 {
@@ -3788,14 +5072,31 @@ void ZoominatorController::uninstallHooks()
 	}
 	g_ctl = nullptr;
 #elif defined(__linux__)
-	if (xiNotifier) {
-		delete xiNotifier;
-		xiNotifier = nullptr;
+	if (xiThread.joinable()) {
+		xiStop.store(true, std::memory_order_release);
+		const uint64_t one = 1;
+		if (write(xiWakeFd, &one, sizeof(one)) < 0)
+			blog(LOG_WARNING, "[Zoominator] Failed to wake input thread (errno %d).", errno);
+		xiThread.join();
+	}
+	if (xiWakeFd >= 0) {
+		close(xiWakeFd);
+		xiWakeFd = -1;
 	}
+	evdevInput.stop();
+	inputEvents.clear();
 	if (xiDisplay) {
 		XCloseDisplay(xiDisplay);
 		xiDisplay = nullptr;
 	}
+	close_shared_x11_display();
+	reset_monitor_topology();
+	g_inputModifiersTracked.store(false, std::memory_order_release);
+	inputCursorValid = false;
+	xiTimeOffsetValid = false;
+	xiAbsoluteDevices.clear();
+	latestCursorValid.store(false);
+	cursorSamples.clear();
 	g_ctl = nullptr;
 #endif
 }
@@ -5,15 +5,34 @@
 
 #include <QObject>
 #include <QPointer>
+#include <QByteArray>
 #include <QKeySequence>
 #include <QSet>
-#include <QSocketNotifier>
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QString>
 #include <QHash>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+#include "zoominator-camera.hpp"
+#include "zoominator-evdev.hpp"
+#include "zoominator-marker-source.hpp"
+#include "zoominator-recovery-index.hpp"
+#include "zoominator-ring-buffer.hpp"
+#include "zoominator-scene-mirror.hpp"
+#include "zoominator-settings-writer.hpp"
+#include "zoominator-stats.hpp"
+#include "zoominator-tick-plan.hpp"
+#include "zoominator-tick-profiler.hpp"
+#include "zoominator-trigger.hpp"
+
+struct ZoominatorJournalRecord;
+
 #ifdef _WIN32
 #	define WIN32_LEAN_AND_MEAN
 #	include <Windows.h>
@@ -40,6 +59,8 @@ public:
 	void saveSettings();
 	void loadSettings();
 	void notifySettingsChanged();
+	void logTickProfile();
+	ZoominatorStatsSnapshot statsSnapshot() const;
 
 	QString screenKey;
 	QString hotkeySequence;
@@ -48,6 +69,7 @@ public:
 
 	QString triggerType;       
 	QString mouseButton;       
+	QString inputBackend; // Linux only: "auto", "xinput2" or "evdev"
 	bool modCtrl = false;
 	bool modAlt = false;
 	bool modShift = false;
@@ -67,6 +89,8 @@ public:
 	bool followMouse = true;
 	bool followMouseRuntimeEnabled = true;
 	double followSpeed = 8.0; 
+	bool frameSync = false;
+	QString zoomMethod = QStringLiteral("items");
 	bool portraitCover = true;
 	bool showCursorMarker = false;
 	bool markerOnlyOnClick = false;
@@ -92,8 +116,19 @@ private:
 	ZoominatorController &operator=(const ZoominatorController &) = delete;
 
 	QString configPath() const;
+	QString recoveryFlagPath() const;
+	QString recoveryJournalPath() const;
+	void writeSettingsSnapshot();
+	void readRecoveryFlag();
+	void writeRecoveryFlag();
 
 	void ensureTicking(bool on);
+	bool isTicking() const;
+	void enterIdle();
+	void wakeFromIdle();
+	bool hasMotionEvents() const;
+	static void obsVideoTick(void *param, float seconds);
+	void onVideoFrame();
 	void startZoomIn();
 	void startZoomOut();
 	void resetState();
@@ -108,9 +143,37 @@ private:
 	bool modsMatch() const;
 
 	bool getSelectedScreenRect(int &x, int &y, int &w, int &h) const;
-	void enumerateTargetItemsInCurrentScene(std::vector<obs_sceneitem_t *> &items) const;
+	mutable QString parsedScreenKey;
+	mutable bool parsedScreenKeyValid = false;
+	mutable int parsedScreenRect[4] = {0, 0, 0, 0};
+
+	// Selected screen and canvas size folded into one cursor -> scene affine
+	// transform. Rebuilt lazily after a screen geometry change, a video reset or
+	// a settings change instead of being looked up for every cursor sample.
+	struct GeometryContext {
+		bool valid = false;
+		double canvasW = 1920.0, canvasH = 1080.0;
+		ZoominatorScreenMap screen;
+		uint32_t baseW = 0, baseH = 0;
+	};
+	mutable GeometryContext geometry;
+	const GeometryContext &geometryContext() const;
+	void invalidateGeometry() { geometry.valid = false; }
+	void watchScreenGeometry();
+	void screensChanged();
+	obs_scene_t *currentMirroredScene();
+	static void sceneMirrorChanged(void *param);
+	bool isMarkerSource(obs_source_t *src) const;
+	void enumerateTargetItemsInCurrentScene(std::vector<obs_sceneitem_t *> &items);
+	obs_sceneitem_t *ensureZoomContainer(obs_scene_t *scene);
+	void releaseZoomContainer();
+	bool ensureCameraFilter(obs_scene_t *scene);
+	void releaseCameraFilter();
 
 	bool getCursorPos(int &x, int &y) const;
+	void publishCursorSample(int x, int y, uint64_t tNs);
+	void integrateFollow(float mx, float my);
+	void stepFollow(float tx, float ty, double dt);
 	bool mapCursorToScenePixels(int cursorX, int cursorY, float &sx, float &sy, bool &cursorInside) const;
 
 	void captureOriginal(obs_sceneitem_t *item);
@@ -118,21 +181,27 @@ private:
 	void captureOriginalSceneItems(const std::vector<obs_sceneitem_t *> &items);
 	void restoreOriginalSceneItems(const std::vector<obs_sceneitem_t *> &items);
 	void restoreOriginalSceneItemsFromState();
-	QString markerImagePath() const;
 	void ensureMarkerSource();
-	obs_sceneitem_t *ensureMarkerItem(obs_scene_t *scene);
+	obs_sceneitem_t *findMarkerItem(obs_scene_t *scene);
+	void releaseMarkerItem();
 	void hideMarkerInScene(obs_scene_t *scene);
-	void rebuildMarkerImage();
-	void ensureMarkerFilter();
 	void applyMarkerOpacity(int opacity255);
 	void updateMarkerAppearance();
 	void updateMarkerPosition(obs_scene_t *scene, double x, double y, int opacity255);
+	void updateMarker(obs_scene_t *scene, const ZoominatorCamera &camera, bool sceneSpace, bool hasPoint,
+			  float sceneX, float sceneY);
+	void updateClickHalos(obs_scene_t *scene, const ZoominatorCamera &camera, bool sceneSpace);
+	obs_sceneitem_t *placeMarkerItem(obs_scene_t *scene, double x, double y, float scale);
 	bool captureMarkerClickPosition();
+	bool captureMarkerClickAt(int cx, int cy);
 	bool isMarkerFlashActive(qint64 nowMs) const;
-	int currentMarkerOpacity(qint64 nowMs);
+	void clearClickHalos();
 	void applyZoomToScene(double t);
 
 	QTimer tickTimer;
+	std::atomic<bool> videoTickArmed{false};
+	std::atomic<uint64_t> pendingFrameNs{0};
+	double frameTickSeconds = 0.0;
 	bool zoomPressed = false;
 	bool zoomLatched = false;
 	bool zoomActive = false;
@@ -140,10 +209,50 @@ private:
 	double animT = 0.0;
 	int animDir = 0;
 
+	ZoominatorSceneMirror sceneMirror;
+	ZoominatorTickProfiler tickProfiler;
+	ZoominatorStats stats;
+	std::atomic<bool> sceneWakePending{false};
+
+	// Marker scene item in the mirrored scene, held by reference. It stays
+	// valid until the mirror reports a structural change that drops it or the
+	// current scene switches.
+	struct MarkerItemHandle {
+		obs_scene_t *scene = nullptr;
+		obs_sceneitem_t *item = nullptr;
+		uint64_t generation = 0;
+		float scale = 1.0f;
+	};
+	MarkerItemHandle markerItem;
+	MarkerItemHandle *markerItemFor(obs_scene_t *scene, bool create);
+
+	bool idle = false;
+	bool applySettled = false;
+	int settledTicks = 0;
+	bool lastTickCursorValid = false;
+	float lastTickCursorX = 0.0f;
+	float lastTickCursorY = 0.0f;
+
 	bool followHasPos = false;
 	float followX = 0.0f;
 	float followY = 0.0f;
 
+	struct CursorSample {
+		uint64_t tNs = 0;
+		int x = 0;
+		int y = 0;
+	};
+
+	ZoominatorSpscRing<CursorSample, 512> cursorSamples;
+	std::atomic<uint64_t> latestCursor{0};
+	std::atomic<bool> latestCursorValid{false};
+	// Set while idle so the first cursor sample from the input thread wakes the
+	// UI once instead of once per motion event.
+	std::atomic<bool> motionWakeArmed{false};
+	bool followCursorValid = false;
+	float followCursorX = 0.0f;
+	float followCursorY = 0.0f;
+
 	bool targetHasPos = false;
 	double tickDeltaSeconds = 1.0 / 60.0;
 	qint64 lastTickMs = 0;
@@ -154,15 +263,22 @@ private:
 	float targetX = 0.0f;
 	float targetY = 0.0f;
 
-	bool markerClickHasPos = false;
-	float markerClickX = 0.0f;
-	float markerClickY = 0.0f;
 	uint32_t markerAppearanceHash = 0;
 	int markerCurrentOpacity = -1;
-	obs_source_t *markerFilter = nullptr;
-	qint64 markerClickFlashStartMs = 0;
-	qint64 markerClickFlashHoldUntilMs = 0;
-	qint64 markerClickFlashFadeOutEndMs = 0;
+
+	// Click flashes, each with its own fade timeline. A new click takes a free
+	// slot or replaces the oldest flash; all of them render through the one
+	// marker source.
+	struct ClickHalo {
+		float x = 0.0f; // scene pixels
+		float y = 0.0f;
+		qint64 startMs = 0;
+		qint64 holdUntilMs = 0;
+		qint64 fadeOutEndMs = 0; // 0 while the slot is free
+	};
+	std::array<ClickHalo, kZoominatorMarkerMaxHalos> clickHalos{};
+	qint64 clickHalosEndMs = 0;
+	static float clickHaloOpacity(const ClickHalo &halo, qint64 nowMs);
 
 	struct OrigState {
 		bool valid = false;
@@ -176,35 +292,86 @@ private:
 		obs_sceneitem_crop crop{};
 		vec2 effectivePos{};
 		vec2 effectiveScale{};
+		bool hiddenByZoom = false;
+		uint64_t generation = 0;
 	};
 
+	using SceneItemKey = ZoominatorSceneItemKey;
+
 	struct SceneItemState {
 		obs_sceneitem_t *item = nullptr;
 		OrigState orig;
-		bool normalized = false;
-		bool lastAppliedValid = false;
-		vec2 lastAppliedPos{};
-		vec2 lastAppliedScale{};
 	};
 
-	QString sceneItemKey(obs_sceneitem_t *item) const;
+	struct TransformOp {
+		obs_sceneitem_t *item = nullptr;
+		obs_scene_t *parent = nullptr;
+		const OrigState *restore = nullptr;
+		vec2 pos{};
+		vec2 scale{};
+		bool setPos = false;
+		bool setScale = false;
+		bool clearBounds = false;
+		bool alignTopLeft = false;
+	};
+
+	bool sceneItemKey(obs_sceneitem_t *item, SceneItemKey &key) const;
 	OrigState readSceneItemTransform(obs_sceneitem_t *item) const;
 	void applySceneItemTransform(obs_sceneitem_t *item, const OrigState &state);
+	void queueTransform(TransformOp op);
+	void commitTransformPlan();
+	static void applyTransformOp(const TransformOp &op);
 	void loadRecoveryMap(obs_data_t *data);
-	void saveRecoveryMap(obs_data_t *data);
+	bool loadRecoveryJournal();
+	void rememberRecoveryState(const SceneItemKey &key, const OrigState &state);
+	void evictOldestRecoveryGeneration();
+	void pruneUnresolvedRecoveryStates();
+	void dropRecoveryStatesForScenes(const QSet<QByteArray> &sceneUuids);
+	void journalRecoveryState(const SceneItemKey &key, const OrigState &state);
+	void journalLegacyRecoveryState(const QString &key, const OrigState &state);
+	void appendJournalRecord(ZoominatorJournalRecord &record, const OrigState &state);
+	static OrigState stateFromJournalRecord(const ZoominatorJournalRecord &record);
+	void flushRecoveryJournal();
+	void resetRecoveryJournal();
+	void compactRecoveryJournal();
 	void scheduleSettingsSave(int delayMs = 250);
+	void rebuildRecoveryIndex();
 	void restoreRecoveryIfNeeded();
 	void markRecoveryActive();
 	void clearRecoveryActive();
+	void finishRecoveryActivation();
 	void requestRecoveryRestore();
 	static void frontendEventCallback(enum obs_frontend_event event, void *data);
 
+	ZoominatorSettingsWriter settingsWriter;
 	std::vector<SceneItemState> sceneItems;
-	QHash<QString, OrigState> recoveryTransforms;
+	std::vector<TransformOp> transformPlan;
+	// Parallel to sceneItems; filled at capture, planned every tick.
+	ZoominatorTickPlanner tickPlanner;
+	std::vector<obs_scene_t *> transformPlanScenes;
+	obs_scene_t *containerScene = nullptr;
+	obs_sceneitem_t *containerItem = nullptr;
+	std::vector<obs_sceneitem_t *> containerHiddenItems;
+	std::vector<int> containerHiddenOrder;
+	obs_source_t *cameraFilter = nullptr;
+	obs_source_t *cameraFilterParent = nullptr;
+	float markerItemScale = 1.0f;
+	QHash<SceneItemKey, OrigState> recoveryTransforms;
+	// Name-keyed "scene::source::id" entries from older versions, kept until restored
+	QHash<QString, OrigState> legacyRecoveryTransforms;
+	// Keys of both maps above, for matching items recreated under a new id
+	ZoominatorRecoveryIndex recoveryIndex;
+	bool recoveryIndexDirty = true;
 	bool pendingSettingsSave = false;
 	bool shuttingDown = false;
 	bool recoveryActive = false;
 	bool restoringRecovery = false;
+	uint64_t recoveryActivation = 0;
+	// Entries in recoveryTransforms tagged with recoveryActivation; when that is
+	// all of them, a full map has nothing older to evict.
+	qsizetype recoveryActivationStates = 0;
+	bool recoveryCapWarned = false;
+	std::string recoveryJournalBatch;
 	bool sceneContentBoundsValid = false;
 	vec2 sceneContentMin{};
 	vec2 sceneContentMax{};
@@ -221,6 +388,24 @@ private:
 	bool followToggleModShift = false;
 	bool followToggleModWin = false;
 
+	// Trigger settings flattened for the input hooks, so a key or button event
+	// is matched with integer compares instead of string and flag checks.
+	struct CompiledTrigger {
+		bool enabled = false;
+		bool keyboard = true;
+		bool toggle = false;
+		bool modifierOnly = false;
+		bool clicks = false;
+		bool followEnabled = false;
+		int keys[2] = {0, 0};
+		ZoominatorModifierMatch mods;
+		int button = 0;
+		int followKeys[2] = {0, 0};
+		ZoominatorModifierMatch followMods;
+	};
+	CompiledTrigger trigger;
+	void compileTrigger();
+
 #ifdef _WIN32
 	static LRESULT CALLBACK kb_hook_proc(int nCode, WPARAM wParam, LPARAM lParam);
 	static LRESULT CALLBACK mouse_hook_proc(int nCode, WPARAM wParam, LPARAM lParam);
@@ -233,9 +418,79 @@ private:
 	CFMachPortRef eventTap = nullptr;
 	CFRunLoopSourceRef runLoopSource = nullptr;
 #elif defined(__linux__)
+	// Raw input is read on a dedicated thread (XInput2 via xiDisplay, or evdev)
+	// that owns inputTrigger and the cursor state below. Only matched triggers
+	// and clicks are handed to the UI thread through inputEvents; motion goes
+	// straight into cursorSamples.
+	enum class InputEventKind : uint8_t { TriggerDown, TriggerUp, TriggerRelease, FollowToggle, Click };
+
+	struct InputEvent {
+		uint64_t tNs = 0;
+		InputEventKind kind = InputEventKind::TriggerDown;
+		int x = 0;
+		int y = 0;
+	};
+
 	_XDisplay *xiDisplay = nullptr;
 	int xiOpcode = 0;
-	QSocketNotifier *xiNotifier = nullptr;
+	std::thread xiThread;
+	int xiWakeFd = -1;
+	std::atomic<bool> xiStop{false};
+	std::mutex inputTriggerLock;
+	CompiledTrigger inputPendingTrigger;
+	std::atomic<uint64_t> inputTriggerGen{0};
+	CompiledTrigger inputTrigger;
+	uint64_t inputTriggerSeen = 0;
+	ZoominatorSpscRing<InputEvent, 256> inputEvents;
+	std::atomic<bool> inputDrainPending{false};
+	std::atomic<int> inputOverflowEdges{0};
+	std::atomic<uint64_t> inputDroppedClicks{0};
+	bool inputCursorValid = false;
+	double inputCursorX = 0.0;
+	double inputCursorY = 0.0;
+	// XInput2 reports root coordinates in device pixels. Qt keeps each screen's
+	// origin and divides the offset within it by that screen's devicePixelRatio,
+	// so the cursor is mapped by the screen it is on. The UI thread publishes the
+	// table like inputPendingTrigger; the primary screen comes first and also
+	// covers points between screens.
+	struct InputScreen {
+		int x = 0;
+		int y = 0;
+		int nativeWidth = 0;
+		int nativeHeight = 0;
+		double scale = 1.0;
+	};
+	bool inputCursorNative = false;
+	std::mutex inputScreensLock;
+	std::vector<InputScreen> inputPendingScreens;
+	std::atomic<uint64_t> inputScreensGen{0};
+	std::vector<InputScreen> inputScreens;
+	uint64_t inputScreensSeen = 0;
+	int inputBoundsX = 0;
+	int inputBoundsY = 0;
+	int inputBoundsWidth = 0;
+	int inputBoundsHeight = 0;
+	uint64_t xiCursorSyncNs = 0;
+	int64_t xiTimeOffsetNs = 0;
+	bool xiTimeOffsetValid = false;
+	QHash<int, bool> xiAbsoluteDevices;
+	ZoominatorEvdevInput evdevInput;
+	QString installedInputBackend;
+	bool installXInput2Hooks();
+	bool installEvdevHooks();
+	static void evdevEvent(const ZoominatorEvdevInput::Event &ev, void *param);
+	const CompiledTrigger &refreshInputTrigger();
+	void matchInputKey(const CompiledTrigger &t, int sym, bool down, uint64_t tNs);
+	void matchInputButton(const CompiledTrigger &t, int button, bool down, uint64_t tNs);
+	void moveInputCursor(double dx, double dy, uint64_t tNs);
+	void updateInputScreens();
+	void mapInputCursor(int &x, int &y);
+	void xiThreadMain();
 	void processXInput2Events();
+	uint64_t xiEventTimeNs(unsigned long serverMs);
+	bool resyncXInput2Cursor(uint64_t nowNs);
+	void postInputEvent(InputEventKind kind, uint64_t tNs, int x = 0, int y = 0);
+	void drainInputEvents();
+	void dispatchInputEvent(const InputEvent &ev);
 #endif
 };
@@ -31,6 +31,7 @@ void signal_handler_disconnect(struct signal_handler *handler, const char *signa
 #include <QSet>
 #include <QSpinBox>
 #include <QTabWidget>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QString>
 
@@ -153,6 +154,9 @@ void ZoominatorDialog::closeEvent(QCloseEvent *event)
 	signal_handler_disconnect(sh, "source_destroy", &ZoominatorDialog::obsSourceChanged, this);
 	signal_handler_disconnect(sh, "source_rename",  &ZoominatorDialog::obsSourceChanged, this);
 
+	if (perfTimer)
+		perfTimer->stop();
+
 	applyToController();
 	QDialog::closeEvent(event);
 }
@@ -345,6 +349,25 @@ void ZoominatorDialog::buildUi()
 		zoomRow->addWidget(mkField("Animate In",   spIn),    1);
 		zoomRow->addWidget(mkField("Animate Out",  spOut),   1);
 		lay->addLayout(zoomRow);
+		lay->addSpacing(10);
+
+		cmbZoomMethod = new QComboBox(page);
+		cmbZoomMethod->addItem("Move each source", "items");
+		cmbZoomMethod->addItem("Camera container (one transform per frame)", "container");
+		cmbZoomMethod->addItem("Camera filter (render-level, sources untouched)", "filter");
+		cmbZoomMethod->setToolTip(
+			"Camera container moves the scene's sources into one private scene while zoomed,"
+			" so large scenes cost the same as small ones. Excluded sources stay on top, unzoomed.\n"
+			"Camera filter zooms the rendered scene with a filter; no source is moved and"
+			" excluded sources are zoomed too.");
+		lay->addWidget(mkField("Zoom Method", cmbZoomMethod));
+		lay->addSpacing(10);
+
+		chkFrameSync = new QCheckBox("Sync updates to video frames", page);
+		chkFrameSync->setToolTip(
+			"Move the camera once per rendered OBS frame instead of on a fixed"
+			" 33 ms timer. Smoother pans at 60 fps and above.");
+		lay->addWidget(chkFrameSync);
 
 		
 		addSection(lay, "Mouse Follow");
@@ -424,7 +447,20 @@ void ZoominatorDialog::buildUi()
 		addSection(lay, "Developer");
 
 		chkDebug = new QCheckBox("Enable debug logging", page);
-		lay->addWidget(chkDebug);
+		chkDebug->setToolTip(
+			"Also records each phase of the zoom tick as an OBS profiler scope,"
+			" which adds a little per-frame overhead.");
+		btnLogTickProfile = new QPushButton("Log Tick Profile", page);
+		btnLogTickProfile->setToolTip(
+			"Write the time spent in each phase of the zoom tick since OBS"
+			" started to the OBS log.");
+
+		auto *devRow = new QHBoxLayout;
+		devRow->setSpacing(12);
+		devRow->addWidget(chkDebug);
+		devRow->addStretch(1);
+		devRow->addWidget(btnLogTickProfile);
+		lay->addLayout(devRow);
 
 		lay->addStretch(1);
 		tabWidget->addTab(page, "Advanced");
@@ -459,6 +495,57 @@ void ZoominatorDialog::buildUi()
 	
 	
 	
+	{
+		perfPage = new QWidget;
+		auto *lay = new QVBoxLayout(perfPage);
+		lay->setContentsMargins(20, 20, 20, 20);
+		lay->setSpacing(0);
+
+		auto *info = new QLabel(
+			"Live counters from the zoom tick, refreshed twice a second while this tab is open.",
+			perfPage);
+		info->setWordWrap(true);
+		lay->addWidget(info);
+
+		auto *grid = new QGridLayout;
+		grid->setHorizontalSpacing(20);
+		grid->setVerticalSpacing(8);
+		auto addRow = [&](const QString &title, QLabel *&value) {
+			const int row = grid->rowCount();
+			value = new QLabel("-", perfPage);
+			value->setTextInteractionFlags(Qt::TextSelectableByMouse);
+			grid->addWidget(new QLabel(title, perfPage), row, 0);
+			grid->addWidget(value, row, 1);
+		};
+
+		addSection(lay, "Tick");
+		addRow("Tick rate", lblTickRate);
+		addRow("Duration p50", lblTickP50);
+		addRow("Duration p95", lblTickP95);
+		addRow("Duration p99", lblTickP99);
+		lay->addLayout(grid);
+
+		addSection(lay, "Updates");
+		grid = new QGridLayout;
+		grid->setHorizontalSpacing(20);
+		grid->setVerticalSpacing(8);
+		addRow("Scene items applied", lblItemsApplied);
+		addRow("Scene items skipped", lblItemsSkipped);
+		addRow("Marker updates", lblMarkerUpdates);
+		addRow("Settings writes", lblSettingsWrites);
+		addRow("Trigger to first frame", lblTriggerLatency);
+		lay->addLayout(grid);
+
+		lay->addStretch(1);
+		tabWidget->addTab(perfPage, "Performance");
+
+		perfTimer = new QTimer(this);
+		perfTimer->setInterval(500);
+	}
+
+	
+	
+	
 	root->addWidget(tabWidget, 1);
 
 	lblStatus = new QLabel(this);
@@ -484,6 +571,35 @@ void ZoominatorDialog::buildUi()
 	connect(btnClearHotkey,             &QPushButton::clicked, this, &ZoominatorDialog::clearHotkey);
 	connect(btnClearFollowToggleHotkey, &QPushButton::clicked, this, &ZoominatorDialog::clearFollowToggleHotkey);
 	connect(btnMarkerColor,             &QPushButton::clicked, this, &ZoominatorDialog::chooseMarkerColor);
+	connect(btnLogTickProfile,          &QPushButton::clicked, this,
+		[]() { ZoominatorController::instance().logTickProfile(); });
+	connect(perfTimer, &QTimer::timeout, this, &ZoominatorDialog::refreshPerformance);
+	connect(tabWidget, &QTabWidget::currentChanged, this, [this](int) {
+		if (tabWidget->currentWidget() == perfPage) {
+			refreshPerformance();
+			perfTimer->start();
+		} else {
+			perfTimer->stop();
+		}
+	});
+}
+
+void ZoominatorDialog::refreshPerformance()
+{
+	if (!perfPage)
+		return;
+
+	const ZoominatorStatsSnapshot s = ZoominatorController::instance().statsSnapshot();
+	lblTickRate->setText(QString("%1 /s").arg(s.tickRateHz, 0, 'f', 0));
+	lblTickP50->setText(QString("%1 ms").arg(s.tickP50Ms, 0, 'f', 3));
+	lblTickP95->setText(QString("%1 ms").arg(s.tickP95Ms, 0, 'f', 3));
+	lblTickP99->setText(QString("%1 ms").arg(s.tickP99Ms, 0, 'f', 3));
+	lblItemsApplied->setText(QString("%1 last frame, %2 total").arg(s.itemsApplied).arg(s.itemsAppliedTotal));
+	lblItemsSkipped->setText(QString("%1 last frame, %2 total").arg(s.itemsSkipped).arg(s.itemsSkippedTotal));
+	lblMarkerUpdates->setText(QString::number(s.markerUpdates));
+	lblSettingsWrites->setText(QString::number(s.settingsWrites));
+	lblTriggerLatency->setText(s.triggerLatencyMs >= 0.0 ? QString("%1 ms").arg(s.triggerLatencyMs, 0, 'f', 1)
+							      : QString("-"));
 }
 
 void ZoominatorDialog::populateSourcesTab()
@@ -670,6 +786,9 @@ void ZoominatorDialog::loadFromController()
 		spZoom->setValue(c.zoomFactor);
 		spIn->setValue(c.animInMs);
 		spOut->setValue(c.animOutMs);
+		chkFrameSync->setChecked(c.frameSync);
+		int methodIdx = cmbZoomMethod->findData(c.zoomMethod);
+		cmbZoomMethod->setCurrentIndex(methodIdx >= 0 ? methodIdx : 0);
 		chkFollow->setChecked(c.followMouse);
 		spFollowSpeed->setValue(c.followSpeed);
 		chkPortraitCover->setChecked(c.portraitCover);
@@ -728,6 +847,8 @@ void ZoominatorDialog::applyToController()
 	c.zoomFactor        = spZoom->value();
 	c.animInMs          = spIn->value();
 	c.animOutMs         = spOut->value();
+	c.frameSync         = chkFrameSync->isChecked();
+	c.zoomMethod        = cmbZoomMethod->currentData().toString();
 	c.followMouse       = chkFollow->isChecked();
 	c.followSpeed       = spFollowSpeed->value();
 	c.portraitCover     = chkPortraitCover->isChecked();
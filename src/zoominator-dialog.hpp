@@ -12,6 +12,7 @@ class QListWidget;
 class QPushButton;
 class QSpinBox;
 class QTabWidget;
+class QTimer;
 struct calldata; 
 
 class ZoominatorDialog final : public QDialog {
@@ -31,6 +32,7 @@ private slots:
 	void clearFollowToggleHotkey();
 	void chooseMarkerColor();
 	void populateSourcesTab();
+	void refreshPerformance();
 
 private:
 	void buildUi();
@@ -73,6 +75,8 @@ private:
 	QDoubleSpinBox *spZoom               = nullptr;
 	QSpinBox       *spIn                 = nullptr;
 	QSpinBox       *spOut                = nullptr;
+	QCheckBox      *chkFrameSync         = nullptr;
+	QComboBox      *cmbZoomMethod        = nullptr;
 	QCheckBox      *chkFollow            = nullptr;
 	QDoubleSpinBox *spFollowSpeed        = nullptr;
 	QCheckBox      *chkPortraitCover     = nullptr;
@@ -82,11 +86,25 @@ private:
 	QSpinBox       *spMarkerThickness    = nullptr;
 	QPushButton    *btnMarkerColor       = nullptr;
 	QCheckBox      *chkDebug             = nullptr;
+	QPushButton    *btnLogTickProfile    = nullptr;
 
 	
 	QListWidget *lstSources = nullptr;
 
 	
+	QWidget *perfPage          = nullptr;
+	QTimer  *perfTimer         = nullptr;
+	QLabel  *lblTickRate       = nullptr;
+	QLabel  *lblTickP50        = nullptr;
+	QLabel  *lblTickP95        = nullptr;
+	QLabel  *lblTickP99        = nullptr;
+	QLabel  *lblItemsApplied   = nullptr;
+	QLabel  *lblItemsSkipped   = nullptr;
+	QLabel  *lblMarkerUpdates  = nullptr;
+	QLabel  *lblSettingsWrites = nullptr;
+	QLabel  *lblTriggerLatency = nullptr;
+
+	
 	QLabel      *lblStatus  = nullptr;
 	QPushButton *btnRefresh = nullptr;
 	QPushButton *btnApply   = nullptr;
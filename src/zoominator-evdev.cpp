@@ -0,0 +1,273 @@
+#include "zoominator-evdev.hpp"
+
+#ifdef __linux__
+
+#include <obs.h>
+
+#include <linux/input.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+static constexpr const char *kInputDir = "/dev/input";
+
+static inline bool test_bit(const unsigned long *bits, int bit)
+{
+	return (bits[bit / (int)(sizeof(long) * CHAR_BIT)] >> (bit % (int)(sizeof(long) * CHAR_BIT))) & 1ul;
+}
+
+#define ZOOMINATOR_NLONGS(n) (((n) + sizeof(long) * CHAR_BIT - 1) / (sizeof(long) * CHAR_BIT))
+
+ZoominatorEvdevInput::~ZoominatorEvdevInput()
+{
+	stop();
+}
+
+bool ZoominatorEvdevInput::openDevice(const std::string &path, bool reportHeld)
+{
+	for (const Device &dev : devices) {
+		if (dev.path == path)
+			return false;
+	}
+
+	const int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	unsigned long evBits[ZOOMINATOR_NLONGS(EV_CNT)] = {};
+	unsigned long keyBits[ZOOMINATOR_NLONGS(KEY_CNT)] = {};
+	unsigned long relBits[ZOOMINATOR_NLONGS(REL_CNT)] = {};
+	ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits);
+	if (test_bit(evBits, EV_KEY))
+		ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+	if (test_bit(evBits, EV_REL))
+		ioctl(fd, EVIOCGBIT(EV_REL, sizeof(relBits)), relBits);
+
+	const bool keyboard = test_bit(keyBits, KEY_A) && test_bit(keyBits, KEY_SPACE);
+	const bool pointer = test_bit(keyBits, BTN_LEFT) || (test_bit(relBits, REL_X) && test_bit(relBits, REL_Y));
+	if (!keyboard && !pointer) {
+		close(fd);
+		return false;
+	}
+
+	int clockId = CLOCK_MONOTONIC;
+	ioctl(fd, EVIOCSCLOCKID, &clockId);
+
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+		close(fd);
+		return false;
+	}
+
+	Device dev;
+	dev.fd = fd;
+	dev.path = path;
+	devices.push_back(dev);
+	deviceTotal.store(devices.size(), std::memory_order_relaxed);
+
+	if (keyboard && reportHeld && sinkFn) {
+		unsigned long held[ZOOMINATOR_NLONGS(KEY_CNT)] = {};
+		if (ioctl(fd, EVIOCGKEY(sizeof(held)), held) >= 0) {
+			timespec now{};
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			for (int code = 0; code < 256; code++) {
+				if (!test_bit(held, code))
+					continue;
+				Event ev;
+				ev.type = EventType::Key;
+				ev.tNs = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+				ev.code = keysymForCode(code);
+				ev.down = true;
+				ev.held = true;
+				if (ev.code != 0)
+					sinkFn(ev, sinkParam);
+			}
+		}
+	}
+	return true;
+}
+
+void ZoominatorEvdevInput::closeDevice(int fd)
+{
+	for (size_t i = 0; i < devices.size(); i++) {
+		if (devices[i].fd != fd)
+			continue;
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+		close(fd);
+		devices.erase(devices.begin() + (ptrdiff_t)i);
+		deviceTotal.store(devices.size(), std::memory_order_relaxed);
+		return;
+	}
+}
+
+void ZoominatorEvdevInput::scanDirectory(bool reportHeld)
+{
+	DIR *dir = opendir(kInputDir);
+	if (!dir)
+		return;
+	while (dirent *entry = readdir(dir)) {
+		if (strncmp(entry->d_name, "event", 5) == 0)
+			openDevice(std::string(kInputDir) + "/" + entry->d_name, reportHeld);
+	}
+	closedir(dir);
+}
+
+void ZoominatorEvdevInput::handleHotplug()
+{
+	alignas(inotify_event) char buf[4096];
+	for (;;) {
+		const ssize_t n = read(notifyFd, buf, sizeof(buf));
+		if (n <= 0)
+			return;
+		// udev fixes up permissions after the node appears, so attribute changes
+		// retry nodes that could not be opened on creation.
+		for (ssize_t off = 0; off < n;) {
+			const auto *ie = reinterpret_cast<const inotify_event *>(buf + off);
+			if (ie->len > 0 && strncmp(ie->name, "event", 5) == 0)
+				openDevice(std::string(kInputDir) + "/" + ie->name, false);
+			off += (ssize_t)(sizeof(inotify_event) + ie->len);
+		}
+	}
+}
+
+void ZoominatorEvdevInput::readDevice(int fd)
+{
+	Device *dev = nullptr;
+	for (Device &d : devices) {
+		if (d.fd == fd) {
+			dev = &d;
+			break;
+		}
+	}
+	if (!dev)
+		return;
+
+	input_event buf[64];
+	for (;;) {
+		const ssize_t n = read(fd, buf, sizeof(buf));
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0 && errno == EAGAIN)
+			return;
+		if (n <= 0) {
+			// ENODEV: the device was unplugged.
+			closeDevice(fd);
+			return;
+		}
+
+		const size_t count = (size_t)n / sizeof(input_event);
+		for (size_t i = 0; i < count; i++)
+			decode(*dev, buf[i], sinkFn, sinkParam);
+		if (count < sizeof(buf) / sizeof(buf[0]))
+			return;
+	}
+}
+
+bool ZoominatorEvdevInput::start(Sink sink, void *param)
+{
+	if (running() || !sink)
+		return running();
+
+	sinkFn = sink;
+	sinkParam = param;
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (epollFd < 0 || wakeFd < 0) {
+		blog(LOG_WARNING, "[Zoominator] evdev: failed to create epoll/eventfd (errno %d).", errno);
+		closeAll();
+		return false;
+	}
+
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.fd = wakeFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+	notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (notifyFd >= 0 && inotify_add_watch(notifyFd, kInputDir, IN_CREATE | IN_ATTRIB) >= 0) {
+		ev.data.fd = notifyFd;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, notifyFd, &ev);
+	} else if (notifyFd >= 0) {
+		close(notifyFd);
+		notifyFd = -1;
+	}
+
+	scanDirectory(true);
+	if (devices.empty()) {
+		blog(LOG_WARNING,
+		     "[Zoominator] evdev: no readable input devices in %s. Add the user to the 'input' group to use "
+		     "this backend.",
+		     kInputDir);
+		closeAll();
+		return false;
+	}
+
+	worker = std::thread(&ZoominatorEvdevInput::run, this);
+	blog(LOG_INFO, "[Zoominator] evdev input started with %d device(s).", (int)devices.size());
+	return true;
+}
+
+void ZoominatorEvdevInput::stop()
+{
+	if (worker.joinable()) {
+		const uint64_t one = 1;
+		if (write(wakeFd, &one, sizeof(one)) < 0)
+			blog(LOG_WARNING, "[Zoominator] evdev: failed to wake reader thread (errno %d).", errno);
+		worker.join();
+	}
+	closeAll();
+}
+
+void ZoominatorEvdevInput::closeAll()
+{
+	for (const Device &dev : devices)
+		close(dev.fd);
+	devices.clear();
+	deviceTotal.store(0, std::memory_order_relaxed);
+	if (notifyFd >= 0)
+		close(notifyFd);
+	if (wakeFd >= 0)
+		close(wakeFd);
+	if (epollFd >= 0)
+		close(epollFd);
+	notifyFd = -1;
+	wakeFd = -1;
+	epollFd = -1;
+}
+
+void ZoominatorEvdevInput::run()
+{
+	epoll_event events[16];
+	for (;;) {
+		const int n = epoll_wait(epollFd, events, 16, -1);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			blog(LOG_WARNING, "[Zoominator] evdev: epoll_wait failed (errno %d); stopping.", errno);
+			return;
+		}
+		for (int i = 0; i < n; i++) {
+			const int fd = events[i].data.fd;
+			if (fd == wakeFd)
+				return;
+			if (fd == notifyFd)
+				handleHotplug();
+			else
+				readDevice(fd);
+		}
+	}
+}
+
+#endif
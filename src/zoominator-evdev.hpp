@@ -0,0 +1,84 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct input_event;
+
+// Global input read straight from /dev/input/event* for sessions where XInput2
+// only sees XWayland clients. Devices are read on an epoll thread and decoded
+// into the key symbols and button numbers the XInput2 path produces, so both
+// backends feed the same trigger matcher. replay() runs the same decoder over a
+// recorded stream (e.g. captured from an event node) without touching devices;
+// it lives with the decoder in zoominator-evdev-decode.cpp, which needs no
+// libobs. Pointer motion is integrated from REL_X/REL_Y only, so devices that
+// report just absolute axes (most touchpads) move no cursor.
+class ZoominatorEvdevInput final {
+public:
+	enum class EventType : uint8_t { Key, Button, Motion };
+
+	struct Event {
+		EventType type = EventType::Key;
+		uint64_t tNs = 0; // CLOCK_MONOTONIC, comparable with os_gettime_ns()
+		int code = 0;     // X keysym (US layout) for keys, X button number for buttons
+		bool down = false;
+		bool held = false; // key was already down when its device was opened
+		int dx = 0;
+		int dy = 0;
+	};
+
+	using Sink = void (*)(const Event &ev, void *param);
+
+	ZoominatorEvdevInput() = default;
+	~ZoominatorEvdevInput();
+	ZoominatorEvdevInput(const ZoominatorEvdevInput &) = delete;
+	ZoominatorEvdevInput &operator=(const ZoominatorEvdevInput &) = delete;
+
+	// Opens every readable keyboard/pointer node and starts the reader thread.
+	// Held keys are reported synchronously before this returns. Fails when no
+	// device could be opened (usually missing membership in the input group).
+	bool start(Sink sink, void *param);
+	void stop();
+	bool running() const { return worker.joinable(); }
+	size_t deviceCount() const { return deviceTotal.load(std::memory_order_relaxed); }
+
+	// Each call decodes as one device starting from a clean state.
+	static void replay(const input_event *events, size_t count, Sink sink, void *param);
+
+	static int keysymForCode(int code);
+	static int buttonForCode(int code);
+
+private:
+	struct Device {
+		int fd = -1;
+		std::string path;
+		int relX = 0;
+		int relY = 0;
+	};
+
+	void run();
+	bool openDevice(const std::string &path, bool reportHeld);
+	void closeDevice(int fd);
+	void readDevice(int fd);
+	void scanDirectory(bool reportHeld);
+	void handleHotplug();
+	void closeAll();
+	static void decode(Device &dev, const input_event &ie, Sink sink, void *param);
+
+	std::vector<Device> devices;
+	std::atomic<size_t> deviceTotal{0};
+	std::thread worker;
+	int epollFd = -1;
+	int wakeFd = -1;
+	int notifyFd = -1;
+	Sink sinkFn = nullptr;
+	void *sinkParam = nullptr;
+};
+
+#endif
@@ -0,0 +1,230 @@
+#include "zoominator-marker-source.hpp"
+
+#include <graphics/vec4.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+struct ZoominatorMarkerSource {
+	obs_source_t *context = nullptr;
+	gs_effect_t *effect = nullptr;
+	gs_eparam_t *colorParam = nullptr;
+	gs_eparam_t *sizeParam = nullptr;
+	gs_eparam_t *radiusParam = nullptr;
+	gs_eparam_t *halfWidthParam = nullptr;
+	gs_eparam_t *edgeParam = nullptr;
+	std::mutex lock;
+	uint32_t size = 26;
+	float thickness = 4.0f;
+	uint32_t color = 0xFFFF0000;
+
+	// width == 0 is the single ring mode: the extent follows the ring size and
+	// halos[0] holds its opacity.
+	uint32_t width = 0;
+	uint32_t height = 0;
+	float ringScale = 1.0f;
+	std::array<ZoominatorMarkerHalo, kZoominatorMarkerMaxHalos> halos{};
+	size_t haloCount = 1;
+};
+
+static ZoominatorMarkerSource *marker_data(obs_source_t *marker)
+{
+	if (!marker)
+		return nullptr;
+	const char *id = obs_source_get_unversioned_id(marker);
+	if (!id || strcmp(id, kZoominatorMarkerSourceId) != 0)
+		return nullptr;
+	return static_cast<ZoominatorMarkerSource *>(obs_obj_get_data(marker));
+}
+
+static const char *marker_source_get_name(void *)
+{
+	return kZoominatorMarkerSourceName;
+}
+
+static void *marker_source_create(obs_data_t *, obs_source_t *source)
+{
+	auto *marker = new ZoominatorMarkerSource();
+	marker->context = source;
+	marker->halos[0].opacity = 1.0f;
+
+	char *path = obs_module_file("zoominator-marker.effect");
+	obs_enter_graphics();
+	marker->effect = path ? gs_effect_create_from_file(path, nullptr) : nullptr;
+	if (marker->effect) {
+		marker->colorParam = gs_effect_get_param_by_name(marker->effect, "color");
+		marker->sizeParam = gs_effect_get_param_by_name(marker->effect, "size");
+		marker->radiusParam = gs_effect_get_param_by_name(marker->effect, "radius");
+		marker->halfWidthParam = gs_effect_get_param_by_name(marker->effect, "half_width");
+		marker->edgeParam = gs_effect_get_param_by_name(marker->effect, "edge");
+	}
+	obs_leave_graphics();
+	if (!marker->effect)
+		blog(LOG_WARNING, "[Zoominator] Failed to load marker effect '%s'.", path ? path : "(null)");
+	bfree(path);
+	return marker;
+}
+
+static void marker_source_destroy(void *data)
+{
+	auto *marker = static_cast<ZoominatorMarkerSource *>(data);
+	if (!marker)
+		return;
+	if (marker->effect) {
+		obs_enter_graphics();
+		gs_effect_destroy(marker->effect);
+		obs_leave_graphics();
+	}
+	delete marker;
+}
+
+static uint32_t marker_source_get_width(void *data)
+{
+	auto *marker = static_cast<ZoominatorMarkerSource *>(data);
+	if (!marker)
+		return 0;
+	std::lock_guard<std::mutex> guard(marker->lock);
+	return marker->width ? marker->width : marker->size;
+}
+
+static uint32_t marker_source_get_height(void *data)
+{
+	auto *marker = static_cast<ZoominatorMarkerSource *>(data);
+	if (!marker)
+		return 0;
+	std::lock_guard<std::mutex> guard(marker->lock);
+	return marker->width ? marker->height : marker->size;
+}
+
+static void marker_source_video_render(void *data, gs_effect_t *)
+{
+	auto *marker = static_cast<ZoominatorMarkerSource *>(data);
+	if (!marker || !marker->effect)
+		return;
+
+	uint32_t size = 0;
+	float thickness = 0.0f;
+	uint32_t color = 0;
+	float ringScale = 1.0f;
+	bool single = true;
+	std::array<ZoominatorMarkerHalo, kZoominatorMarkerMaxHalos> halos;
+	size_t haloCount = 0;
+	{
+		std::lock_guard<std::mutex> guard(marker->lock);
+		size = marker->size;
+		thickness = marker->thickness;
+		color = marker->color;
+		single = marker->width == 0;
+		ringScale = single ? 1.0f : marker->ringScale;
+		haloCount = marker->haloCount;
+		std::copy_n(marker->halos.begin(), haloCount, halos.begin());
+	}
+	if (size == 0 || haloCount == 0 || ringScale <= 0.0f)
+		return;
+
+	// Same ring geometry the old painted image used: the stroke is inset by
+	// half its width plus a small margin so the antialiased edge never clips.
+	const float extent = (float)size * ringScale;
+	const float halfWidth = thickness * 0.5f * ringScale;
+	const float radius = extent * 0.5f - (thickness * 0.5f + 1.5f) * ringScale;
+
+	// obs_data colors are 0xAABBGGRR; the marker setting is Qt's 0xAARRGGBB.
+	const uint32_t abgr = (color & 0xFF00FF00u) | ((color >> 16) & 0xFFu) | ((color & 0xFFu) << 16);
+	vec4 linear{};
+	vec4_from_rgba_srgb(&linear, abgr | 0xFF000000u);
+
+	const bool previousSrgb = gs_framebuffer_srgb_enabled();
+	gs_enable_framebuffer_srgb(true);
+	gs_blend_state_push();
+	gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+	gs_effect_set_float(marker->sizeParam, extent);
+	gs_effect_set_float(marker->radiusParam, radius);
+	gs_effect_set_float(marker->halfWidthParam, halfWidth);
+	gs_effect_set_float(marker->edgeParam, ringScale);
+
+	// One technique pass for the whole pool; only the colour and the quad's
+	// offset change between halos.
+	while (gs_effect_loop(marker->effect, "Draw")) {
+		for (size_t i = 0; i < haloCount; i++) {
+			const ZoominatorMarkerHalo &halo = halos[i];
+			if (halo.opacity <= 0.0f)
+				continue;
+			linear.w = std::min(halo.opacity, 1.0f);
+			gs_effect_set_vec4(marker->colorParam, &linear);
+			gs_matrix_push();
+			if (!single)
+				gs_matrix_translate3f(halo.x - extent * 0.5f, halo.y - extent * 0.5f, 0.0f);
+			gs_draw_sprite(nullptr, 0, (uint32_t)std::ceil(extent), (uint32_t)std::ceil(extent));
+			gs_matrix_pop();
+		}
+	}
+
+	gs_blend_state_pop();
+	gs_enable_framebuffer_srgb(previousSrgb);
+}
+
+void zoominator_marker_source_register()
+{
+	obs_source_info info{};
+	info.id = kZoominatorMarkerSourceId;
+	info.type = OBS_SOURCE_TYPE_INPUT;
+	info.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_CUSTOM_DRAW | OBS_SOURCE_CAP_DISABLED;
+	info.get_name = marker_source_get_name;
+	info.create = marker_source_create;
+	info.destroy = marker_source_destroy;
+	info.get_width = marker_source_get_width;
+	info.get_height = marker_source_get_height;
+	info.video_render = marker_source_video_render;
+	obs_register_source(&info);
+}
+
+void zoominator_marker_source_set_appearance(obs_source_t *marker, int size, int thickness, uint32_t argb)
+{
+	ZoominatorMarkerSource *data = marker_data(marker);
+	if (!data)
+		return;
+
+	const int clampedSize = std::clamp(size, 6, 512);
+	const float clampedThickness =
+		std::clamp((float)thickness, 1.0f, std::max(1.0f, (float)clampedSize / 2.0f - 2.0f));
+
+	std::lock_guard<std::mutex> guard(data->lock);
+	data->size = (uint32_t)clampedSize;
+	data->thickness = clampedThickness;
+	data->color = argb;
+}
+
+void zoominator_marker_source_set_ring(obs_source_t *marker, float opacity)
+{
+	ZoominatorMarkerSource *data = marker_data(marker);
+	if (!data)
+		return;
+
+	std::lock_guard<std::mutex> guard(data->lock);
+	data->width = 0;
+	data->height = 0;
+	data->ringScale = 1.0f;
+	data->halos[0] = ZoominatorMarkerHalo();
+	data->halos[0].opacity = std::clamp(opacity, 0.0f, 1.0f);
+	data->haloCount = 1;
+}
+
+void zoominator_marker_source_set_halos(obs_source_t *marker, uint32_t width, uint32_t height, float ringScale,
+				       const ZoominatorMarkerHalo *halos, size_t count)
+{
+	ZoominatorMarkerSource *data = marker_data(marker);
+	if (!data || width == 0 || height == 0)
+		return;
+
+	count = halos ? std::min(count, kZoominatorMarkerMaxHalos) : 0;
+	std::lock_guard<std::mutex> guard(data->lock);
+	data->width = width;
+	data->height = height;
+	data->ringScale = ringScale;
+	std::copy_n(halos, count, data->halos.begin());
+	data->haloCount = count;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <obs-module.h>
+
+#include <cstddef>
+#include <cstdint>
+
+static constexpr const char *kZoominatorMarkerSourceId = "zoominator_marker_source";
+static constexpr const char *kZoominatorMarkerSourceName = "Zoominator Cursor Marker";
+
+static constexpr size_t kZoominatorMarkerMaxHalos = 16;
+
+// One ring instance, centred at (x, y) in source pixels.
+struct ZoominatorMarkerHalo {
+	float x = 0.0f;
+	float y = 0.0f;
+	float opacity = 0.0f;
+};
+
+// Video source that draws the cursor ring procedurally from parameters held in
+// memory. It has no settings; the controller drives it through the setters, so
+// changing the look or fading the ring never touches disk or obs_data_t.
+//
+// By default the source is one ring in a square of the ring's size. With
+// set_halos it instead spans width x height and draws up to
+// kZoominatorMarkerMaxHalos rings in one pass, so overlapping click flashes
+// share a single scene item.
+void zoominator_marker_source_register();
+void zoominator_marker_source_set_appearance(obs_source_t *marker, int size, int thickness, uint32_t argb);
+void zoominator_marker_source_set_ring(obs_source_t *marker, float opacity);
+void zoominator_marker_source_set_halos(obs_source_t *marker, uint32_t width, uint32_t height, float ringScale,
+				       const ZoominatorMarkerHalo *halos, size_t count);
@@ -0,0 +1,64 @@
+#include "zoominator-recovery-index.hpp"
+
+#include <charconv>
+
+void ZoominatorRecoveryIndex::clear()
+{
+	keys.clear();
+	pairs.clear();
+	legacy.clear();
+}
+
+void ZoominatorRecoveryIndex::add(const ZoominatorSceneItemKey &key)
+{
+	if (!keys.insert(key).second)
+		return;
+
+	ZoominatorSceneItemKey pair = key;
+	pair.itemId = 0;
+	PairEntry &entry = pairs[pair];
+	if (entry.count++ == 0)
+		entry.key = key;
+}
+
+void ZoominatorRecoveryIndex::addLegacy(const std::string &key)
+{
+	const size_t sep = key.rfind("::");
+	if (sep == std::string::npos || sep == 0)
+		return;
+
+	const char *first = key.data() + sep + 2;
+	const char *last = key.data() + key.size();
+	int64_t itemId = 0;
+	const auto parsed = std::from_chars(first, last, itemId);
+	if (first == last || parsed.ec != std::errc() || parsed.ptr != last)
+		return;
+
+	legacy[key.substr(0, sep)].emplace(itemId, key);
+}
+
+const ZoominatorSceneItemKey *ZoominatorRecoveryIndex::resolve(const ZoominatorSceneItemKey &key) const
+{
+	auto exact = keys.find(key);
+	if (exact != keys.end())
+		return &*exact;
+
+	ZoominatorSceneItemKey pair = key;
+	pair.itemId = 0;
+	auto bySource = pairs.find(pair);
+	if (bySource != pairs.end() && bySource->second.count == 1)
+		return &bySource->second.key;
+	return nullptr;
+}
+
+const std::string *ZoominatorRecoveryIndex::resolveLegacy(const std::string &sceneSource, int64_t itemId) const
+{
+	auto bySource = legacy.find(sceneSource);
+	if (bySource == legacy.end())
+		return nullptr;
+
+	auto byId = bySource->second.find(itemId);
+	if (byId == bySource->second.end() && bySource->second.size() == 1)
+		byId = bySource->second.begin();
+	return byId != bySource->second.end() ? &byId->second : nullptr;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Lookup half of crash recovery: which remembered entry a scene item found
+// while walking the loaded collection is restored from. Free of libobs and
+// Qt; the controller owns the saved transforms and rebuilds this index
+// whenever their key set changes.
+
+// Identity of a scene item that survives renames: the UUIDs of its scene
+// and source plus the item id, packed so hashing never formats a string.
+struct ZoominatorSceneItemKey {
+	uint8_t scene[16]{};
+	uint8_t source[16]{};
+	int64_t itemId = 0;
+
+	bool operator==(const ZoominatorSceneItemKey &other) const { return memcmp(this, &other, sizeof(*this)) == 0; }
+
+	size_t hash(size_t seed = 0) const noexcept
+	{
+		uint64_t words[5];
+		memcpy(words, this, sizeof(words));
+		uint64_t h = seed ^ 0x9e3779b97f4a7c15ull;
+		for (uint64_t w : words) {
+			h = (h ^ w) * 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+		}
+		return (size_t)h;
+	}
+
+	// Picked up by QHash through argument-dependent lookup.
+	friend size_t qHash(const ZoominatorSceneItemKey &key, size_t seed = 0) noexcept { return key.hash(seed); }
+};
+
+class ZoominatorRecoveryIndex final {
+public:
+	void clear();
+	void add(const ZoominatorSceneItemKey &key);
+	// Name-based "scene::source::id" keys from older versions; anything that
+	// does not parse is left out and can never match.
+	void addLegacy(const std::string &key);
+
+	// The entry saved for key, or else the lone entry for the same scene and
+	// source, taken as the item recreated under a new id. Null when neither
+	// exists or the scene/source pair is ambiguous.
+	const ZoominatorSceneItemKey *resolve(const ZoominatorSceneItemKey &key) const;
+	// Same rules for legacy entries, given "scene::source" and the item id.
+	const std::string *resolveLegacy(const std::string &sceneSource, int64_t itemId) const;
+
+private:
+	struct KeyHash {
+		size_t operator()(const ZoominatorSceneItemKey &key) const noexcept { return key.hash(); }
+	};
+
+	// Scene/source pair with the item id zeroed.
+	struct PairEntry {
+		size_t count = 0;
+		ZoominatorSceneItemKey key;
+	};
+
+	std::unordered_set<ZoominatorSceneItemKey, KeyHash> keys;
+	std::unordered_map<ZoominatorSceneItemKey, PairEntry, KeyHash> pairs;
+	// "scene::source" -> item id -> full legacy key
+	std::unordered_map<std::string, std::unordered_map<int64_t, std::string>> legacy;
+};
@@ -0,0 +1,230 @@
+#include "zoominator-recovery-journal.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static constexpr char kJournalMagic[4] = {'Z', 'M', 'R', 'J'};
+static constexpr uint32_t kJournalVersion = 2;
+static constexpr uint8_t kKeyUuid = 0;
+static constexpr uint8_t kKeyLegacy = 1;
+static constexpr uint32_t kMaxPayload = 64 * 1024;
+
+static uint32_t fnv1a(const char *data, size_t len)
+{
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < len; i++) {
+		h ^= (uint8_t)data[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void put_u8(std::string &out, uint8_t v)
+{
+	out.push_back((char)v);
+}
+
+static void put_u16(std::string &out, uint16_t v)
+{
+	put_u8(out, (uint8_t)(v & 0xff));
+	put_u8(out, (uint8_t)(v >> 8));
+}
+
+static void put_u32(std::string &out, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		put_u8(out, (uint8_t)(v >> (i * 8)));
+}
+
+static void put_u64(std::string &out, uint64_t v)
+{
+	for (int i = 0; i < 8; i++)
+		put_u8(out, (uint8_t)(v >> (i * 8)));
+}
+
+static void put_f32(std::string &out, float v)
+{
+	uint32_t bits = 0;
+	memcpy(&bits, &v, sizeof(bits));
+	put_u32(out, bits);
+}
+
+struct Reader {
+	const char *p = nullptr;
+	size_t left = 0;
+
+	bool u8(uint8_t &v)
+	{
+		if (left < 1)
+			return false;
+		v = (uint8_t)*p++;
+		left--;
+		return true;
+	}
+
+	bool u16(uint16_t &v)
+	{
+		uint8_t lo = 0, hi = 0;
+		if (!u8(lo) || !u8(hi))
+			return false;
+		v = (uint16_t)(lo | (hi << 8));
+		return true;
+	}
+
+	bool u32(uint32_t &v)
+	{
+		v = 0;
+		for (int i = 0; i < 4; i++) {
+			uint8_t b = 0;
+			if (!u8(b))
+				return false;
+			v |= (uint32_t)b << (i * 8);
+		}
+		return true;
+	}
+
+	bool u64(uint64_t &v)
+	{
+		v = 0;
+		for (int i = 0; i < 8; i++) {
+			uint8_t b = 0;
+			if (!u8(b))
+				return false;
+			v |= (uint64_t)b << (i * 8);
+		}
+		return true;
+	}
+
+	bool i32(int32_t &v)
+	{
+		uint32_t bits = 0;
+		if (!u32(bits))
+			return false;
+		v = (int32_t)bits;
+		return true;
+	}
+
+	bool f32(float &v)
+	{
+		uint32_t bits = 0;
+		if (!u32(bits))
+			return false;
+		memcpy(&v, &bits, sizeof(v));
+		return true;
+	}
+
+	bool bytes(std::string &out, size_t n)
+	{
+		if (left < n)
+			return false;
+		out.assign(p, n);
+		p += n;
+		left -= n;
+		return true;
+	}
+};
+
+static bool read_key(Reader &rec, uint32_t version, ZoominatorJournalRecord &r)
+{
+	uint8_t kind = kKeyLegacy;
+	if (version >= 2 && !rec.u8(kind))
+		return false;
+
+	if (kind == kKeyUuid) {
+		std::string scene, source;
+		uint64_t itemId = 0;
+		if (!rec.bytes(scene, sizeof(r.sceneUuid)) || !rec.bytes(source, sizeof(r.sourceUuid)) ||
+		    !rec.u64(itemId))
+			return false;
+		memcpy(r.sceneUuid, scene.data(), sizeof(r.sceneUuid));
+		memcpy(r.sourceUuid, source.data(), sizeof(r.sourceUuid));
+		r.itemId = (int64_t)itemId;
+		return true;
+	}
+
+	uint16_t keyLen = 0;
+	return kind == kKeyLegacy && rec.u16(keyLen) && rec.bytes(r.legacyKey, keyLen) && !r.legacyKey.empty();
+}
+
+std::string zoominator_journal_header()
+{
+	std::string out(kJournalMagic, sizeof(kJournalMagic));
+	put_u32(out, kJournalVersion);
+	return out;
+}
+
+void zoominator_journal_encode(std::string &out, const ZoominatorJournalRecord &r)
+{
+	std::string payload;
+	payload.reserve(96 + r.legacyKey.size());
+	put_u64(payload, r.activation);
+	if (r.legacyKey.empty()) {
+		put_u8(payload, kKeyUuid);
+		payload.append((const char *)r.sceneUuid, sizeof(r.sceneUuid));
+		payload.append((const char *)r.sourceUuid, sizeof(r.sourceUuid));
+		put_u64(payload, (uint64_t)r.itemId);
+	} else {
+		put_u8(payload, kKeyLegacy);
+		const uint16_t keyLen = (uint16_t)std::min<size_t>(r.legacyKey.size(), 0xffff);
+		put_u16(payload, keyLen);
+		payload.append(r.legacyKey.data(), keyLen);
+	}
+	put_f32(payload, r.posX);
+	put_f32(payload, r.posY);
+	put_f32(payload, r.scaleX);
+	put_f32(payload, r.scaleY);
+	put_f32(payload, r.rot);
+	put_u32(payload, r.align);
+	put_u32(payload, r.boundsType);
+	put_u32(payload, r.boundsAlign);
+	put_f32(payload, r.boundsX);
+	put_f32(payload, r.boundsY);
+	put_u32(payload, (uint32_t)r.cropLeft);
+	put_u32(payload, (uint32_t)r.cropTop);
+	put_u32(payload, (uint32_t)r.cropRight);
+	put_u32(payload, (uint32_t)r.cropBottom);
+	put_u8(payload, r.hiddenByZoom ? 1 : 0);
+
+	put_u32(out, (uint32_t)payload.size());
+	put_u32(out, fnv1a(payload.data(), payload.size()));
+	out += payload;
+}
+
+bool zoominator_journal_decode(const std::string &bytes, std::vector<ZoominatorJournalRecord> &records)
+{
+	records.clear();
+
+	Reader in{bytes.data(), bytes.size()};
+	std::string magic;
+	uint32_t version = 0;
+	if (!in.bytes(magic, sizeof(kJournalMagic)) || memcmp(magic.data(), kJournalMagic, sizeof(kJournalMagic)) != 0)
+		return false;
+	if (!in.u32(version) || version < 1 || version > kJournalVersion)
+		return false;
+
+	for (;;) {
+		uint32_t len = 0, sum = 0;
+		std::string payload;
+		if (!in.u32(len) || !in.u32(sum) || len > kMaxPayload || !in.bytes(payload, len))
+			break;
+		if (fnv1a(payload.data(), payload.size()) != sum)
+			break;
+
+		Reader rec{payload.data(), payload.size()};
+		ZoominatorJournalRecord r;
+		uint8_t flags = 0;
+		if (!rec.u64(r.activation) || !read_key(rec, version, r))
+			break;
+		const bool ok = rec.f32(r.posX) && rec.f32(r.posY) && rec.f32(r.scaleX) && rec.f32(r.scaleY) &&
+				rec.f32(r.rot) && rec.u32(r.align) && rec.u32(r.boundsType) &&
+				rec.u32(r.boundsAlign) && rec.f32(r.boundsX) && rec.f32(r.boundsY) &&
+				rec.i32(r.cropLeft) && rec.i32(r.cropTop) && rec.i32(r.cropRight) &&
+				rec.i32(r.cropBottom) && rec.u8(flags);
+		if (!ok)
+			break;
+		r.hiddenByZoom = (flags & 1) != 0;
+		records.push_back(std::move(r));
+	}
+
+	return true;
+}
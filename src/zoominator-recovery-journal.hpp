@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary crash-recovery journal. The file is a fixed header followed by
+// length-prefixed, checksummed records that are only ever appended; replay
+// stops at the first torn or corrupt record so a crash mid-append loses at
+// most the record being written.
+//
+//   header : "ZMRJ" u32 version
+//   record : u32 payloadLen, u32 fnv1a(payload), payload
+//   payload: u64 activation, u8 keyKind, key, transform fields (LE)
+//   key    : scene UUID[16], source UUID[16], i64 item id   (keyKind 0)
+//            u16 len, "scene::source::id" bytes             (keyKind 1)
+//
+// Version 1 journals only stored the name-based key and are still read.
+
+struct ZoominatorJournalRecord {
+	uint64_t activation = 0;
+	uint8_t sceneUuid[16]{};
+	uint8_t sourceUuid[16]{};
+	int64_t itemId = 0;
+	// Name-based key from older versions; empty when the UUID fields are set.
+	std::string legacyKey;
+	float posX = 0.0f;
+	float posY = 0.0f;
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	float rot = 0.0f;
+	uint32_t align = 0;
+	uint32_t boundsType = 0;
+	uint32_t boundsAlign = 0;
+	float boundsX = 0.0f;
+	float boundsY = 0.0f;
+	int32_t cropLeft = 0;
+	int32_t cropTop = 0;
+	int32_t cropRight = 0;
+	int32_t cropBottom = 0;
+	bool hiddenByZoom = false;
+};
+
+std::string zoominator_journal_header();
+void zoominator_journal_encode(std::string &out, const ZoominatorJournalRecord &record);
+bool zoominator_journal_decode(const std::string &bytes, std::vector<ZoominatorJournalRecord> &records);
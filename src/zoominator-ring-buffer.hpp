@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity single-producer / single-consumer queue. push() may only be
+// called from one thread and pop()/clear() from one (possibly different) thread.
+template<typename T, size_t Capacity> class ZoominatorSpscRing {
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	bool push(const T &value)
+	{
+		const size_t head = headIdx.load(std::memory_order_relaxed);
+		const size_t tail = tailIdx.load(std::memory_order_acquire);
+		if (head - tail >= Capacity)
+			return false;
+		slots[head & (Capacity - 1)] = value;
+		headIdx.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &out)
+	{
+		const size_t tail = tailIdx.load(std::memory_order_relaxed);
+		const size_t head = headIdx.load(std::memory_order_acquire);
+		if (tail == head)
+			return false;
+		out = slots[tail & (Capacity - 1)];
+		tailIdx.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	void clear() { tailIdx.store(headIdx.load(std::memory_order_acquire), std::memory_order_release); }
+
+	bool empty() const
+	{
+		return tailIdx.load(std::memory_order_acquire) == headIdx.load(std::memory_order_acquire);
+	}
+
+private:
+	alignas(64) std::atomic<size_t> headIdx{0};
+	alignas(64) std::atomic<size_t> tailIdx{0};
+	T slots[Capacity]{};
+};
@@ -0,0 +1,182 @@
+#include "zoominator-scene-mirror.hpp"
+
+#include <algorithm>
+
+static const char *const kStructureSignals[] = {"item_add", "item_remove", "refresh"};
+static const char *const kOrderSignals[] = {"reorder"};
+
+ZoominatorSceneMirror::~ZoominatorSceneMirror()
+{
+	reset();
+}
+
+void ZoominatorSceneMirror::setChangedCallback(ChangedCallback cb, void *param)
+{
+	changedCb = cb;
+	changedParam = param;
+}
+
+void ZoominatorSceneMirror::bind(obs_scene_t *scene)
+{
+	if (scene == root)
+		return;
+
+	disconnectAll();
+	items.clear();
+	itemSet.clear();
+	topLevelBySource.clear();
+	root = scene;
+	dirty.store(true);
+}
+
+void ZoominatorSceneMirror::reset()
+{
+	bind(nullptr);
+}
+
+bool ZoominatorSceneMirror::sync()
+{
+	if (!dirty.exchange(false))
+		return false;
+	rebuild();
+	return true;
+}
+
+const std::vector<ZoominatorSceneMirror::Entry> &ZoominatorSceneMirror::entries()
+{
+	sync();
+	return items;
+}
+
+bool ZoominatorSceneMirror::contains(obs_sceneitem_t *item)
+{
+	if (!item)
+		return false;
+	sync();
+	return itemSet.find(item) != itemSet.end();
+}
+
+obs_sceneitem_t *ZoominatorSceneMirror::findTopLevel(obs_source_t *source)
+{
+	if (!source)
+		return nullptr;
+	sync();
+	auto it = topLevelBySource.find(source);
+	return it != topLevelBySource.end() ? it->second : nullptr;
+}
+
+void ZoominatorSceneMirror::structureSignal(void *data, calldata_t *)
+{
+	auto *mirror = static_cast<ZoominatorSceneMirror *>(data);
+	if (!mirror)
+		return;
+	mirror->dirty.store(true);
+	mirror->notifyChanged();
+}
+
+void ZoominatorSceneMirror::orderSignal(void *data, calldata_t *)
+{
+	// Reordering never changes which items are live, so membership stays valid
+	// and only listeners are told that the scene changed.
+	auto *mirror = static_cast<ZoominatorSceneMirror *>(data);
+	if (mirror)
+		mirror->notifyChanged();
+}
+
+void ZoominatorSceneMirror::notifyChanged()
+{
+	if (changedCb)
+		changedCb(changedParam);
+}
+
+void ZoominatorSceneMirror::rebuild()
+{
+	disconnectAll();
+	items.clear();
+	itemSet.clear();
+	topLevelBySource.clear();
+
+	if (!root)
+		return;
+
+	connectScene(obs_scene_get_source(root));
+	collect(root, true);
+	gen++;
+}
+
+void ZoominatorSceneMirror::collect(obs_scene_t *scene, bool topLevel)
+{
+	struct Ctx {
+		ZoominatorSceneMirror *mirror = nullptr;
+		bool topLevel = false;
+		std::vector<obs_scene_t *> nested;
+	};
+
+	Ctx ctx;
+	ctx.mirror = this;
+	ctx.topLevel = topLevel;
+
+	// Nested scenes are walked after the enumeration returns so the parent's
+	// scene mutex is not held while descending.
+	obs_scene_enum_items(
+		scene,
+		[](obs_scene_t *parent, obs_sceneitem_t *item, void *param) -> bool {
+			auto *ctx = static_cast<Ctx *>(param);
+			if (!ctx || !item)
+				return true;
+
+			Entry entry;
+			entry.item = item;
+			entry.source = obs_sceneitem_get_source(item);
+			entry.parent = parent;
+			entry.topLevel = ctx->topLevel;
+			obs_scene_t *subScene = entry.source ? obs_scene_from_source(entry.source) : nullptr;
+			entry.isScene = subScene != nullptr;
+
+			ctx->mirror->items.push_back(entry);
+			ctx->mirror->itemSet.insert(item);
+			if (ctx->topLevel && entry.source)
+				ctx->mirror->topLevelBySource.emplace(entry.source, item);
+			if (subScene)
+				ctx->nested.push_back(subScene);
+			return true;
+		},
+		&ctx);
+
+	for (obs_scene_t *subScene : ctx.nested) {
+		connectScene(obs_scene_get_source(subScene));
+		collect(subScene, false);
+	}
+}
+
+void ZoominatorSceneMirror::connectScene(obs_source_t *sceneSource)
+{
+	if (!sceneSource)
+		return;
+	if (std::find(connected.begin(), connected.end(), sceneSource) != connected.end())
+		return;
+
+	obs_source_t *ref = obs_source_get_ref(sceneSource);
+	if (!ref)
+		return;
+
+	signal_handler_t *sh = obs_source_get_signal_handler(ref);
+	for (const char *signal : kStructureSignals)
+		signal_handler_connect(sh, signal, structureSignal, this);
+	for (const char *signal : kOrderSignals)
+		signal_handler_connect(sh, signal, orderSignal, this);
+	connected.push_back(ref);
+}
+
+void ZoominatorSceneMirror::disconnectAll()
+{
+	for (obs_source_t *src : connected) {
+		signal_handler_t *sh = obs_source_get_signal_handler(src);
+		for (const char *signal : kStructureSignals)
+			signal_handler_disconnect(sh, signal, structureSignal, this);
+		for (const char *signal : kOrderSignals)
+			signal_handler_disconnect(sh, signal, orderSignal, this);
+		obs_source_release(src);
+	}
+	connected.clear();
+}
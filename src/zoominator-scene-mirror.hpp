@@ -0,0 +1,60 @@
+#pragma once
+
+#include <obs.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// In-memory copy of the current scene tree (the scene plus every nested scene
+// reachable from it). Membership is rebuilt lazily on the UI thread after OBS
+// reports a structural change through the scene signals, so liveness checks
+// and marker lookups are hash lookups instead of recursive scene walks.
+class ZoominatorSceneMirror final {
+public:
+	struct Entry {
+		obs_sceneitem_t *item = nullptr;
+		obs_source_t *source = nullptr;
+		obs_scene_t *parent = nullptr;
+		bool isScene = false;
+		bool topLevel = false;
+	};
+
+	using ChangedCallback = void (*)(void *param);
+
+	ZoominatorSceneMirror() = default;
+	~ZoominatorSceneMirror();
+	ZoominatorSceneMirror(const ZoominatorSceneMirror &) = delete;
+	ZoominatorSceneMirror &operator=(const ZoominatorSceneMirror &) = delete;
+
+	void setChangedCallback(ChangedCallback cb, void *param);
+	void bind(obs_scene_t *scene);
+	void reset();
+	bool sync();
+
+	obs_scene_t *scene() const { return root; }
+	const std::vector<Entry> &entries();
+	bool contains(obs_sceneitem_t *item);
+	obs_sceneitem_t *findTopLevel(obs_source_t *source);
+	uint64_t generation() const { return gen; }
+
+private:
+	static void structureSignal(void *data, calldata_t *cd);
+	static void orderSignal(void *data, calldata_t *cd);
+	void notifyChanged();
+	void rebuild();
+	void collect(obs_scene_t *scene, bool topLevel);
+	void connectScene(obs_source_t *sceneSource);
+	void disconnectAll();
+
+	obs_scene_t *root = nullptr;
+	std::vector<obs_source_t *> connected;
+	std::vector<Entry> items;
+	std::unordered_set<obs_sceneitem_t *> itemSet;
+	std::unordered_map<obs_source_t *, obs_sceneitem_t *> topLevelBySource;
+	std::atomic<bool> dirty{true};
+	uint64_t gen = 0;
+	ChangedCallback changedCb = nullptr;
+	void *changedParam = nullptr;
+};
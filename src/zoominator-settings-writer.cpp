@@ -0,0 +1,262 @@
+#include "zoominator-settings-writer.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#	include <io.h>
+#else
+#	include <unistd.h>
+#endif
+
+ZoominatorSettingsWriter::~ZoominatorSettingsWriter()
+{
+	stop();
+}
+
+void ZoominatorSettingsWriter::start()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (running)
+		return;
+	stopping = false;
+	running = true;
+	worker = std::thread(&ZoominatorSettingsWriter::run, this);
+}
+
+void ZoominatorSettingsWriter::stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!running)
+			return;
+		stopping = true;
+	}
+	wake.notify_all();
+	if (worker.joinable())
+		worker.join();
+
+	std::lock_guard<std::mutex> guard(lock);
+	running = false;
+}
+
+void ZoominatorSettingsWriter::flush()
+{
+	std::unique_lock<std::mutex> lk(lock);
+	if (!running)
+		return;
+	drained.wait(lk, [this]() { return pending.empty() && !writing; });
+}
+
+void ZoominatorSettingsWriter::submitJson(const std::string &path, obs_data_t *snapshot)
+{
+	if (path.empty() || !snapshot) {
+		obs_data_release(snapshot);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		Pending &slot = slotFor(path);
+		obs_data_release(slot.json);
+		slot.json = snapshot;
+		slot.text.clear();
+		slot.append.clear();
+		slot.replace = true;
+	}
+	wake.notify_one();
+}
+
+void ZoominatorSettingsWriter::submitText(const std::string &path, std::string text)
+{
+	if (path.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		Pending &slot = slotFor(path);
+		obs_data_release(slot.json);
+		slot.json = nullptr;
+		slot.text = std::move(text);
+		slot.append.clear();
+		slot.replace = true;
+	}
+	wake.notify_one();
+}
+
+void ZoominatorSettingsWriter::submitAppend(const std::string &path, const std::string &bytes)
+{
+	if (path.empty() || bytes.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		slotFor(path).append += bytes;
+	}
+	wake.notify_one();
+}
+
+ZoominatorSettingsWriter::Pending &ZoominatorSettingsWriter::slotFor(const std::string &path)
+{
+	// Resubmitting a path moves it behind everything submitted before, so
+	// the queue stays ordered by each path's latest submission.
+	auto it = std::find_if(pending.begin(), pending.end(), [&](const Pending &p) { return p.path == path; });
+	if (it == pending.end()) {
+		pending.emplace_back();
+		pending.back().path = path;
+		return pending.back();
+	}
+	std::rotate(it, it + 1, pending.end());
+	return pending.back();
+}
+
+void ZoominatorSettingsWriter::requeue(std::vector<Pending> &failed)
+{
+	// Failed entries were submitted before anything still pending, so they go
+	// back in front, unless a newer entry for the same path already exists.
+	// A newer replacement supersedes the failed one outright; newer appends
+	// keep their place and pick up the failed content ahead of their own.
+	auto insertAt = pending.begin();
+	for (Pending &item : failed) {
+		auto newer = std::find_if(pending.begin(), pending.end(),
+					  [&](const Pending &p) { return p.path == item.path; });
+		if (newer == pending.end()) {
+			insertAt = pending.insert(insertAt, std::move(item)) + 1;
+			continue;
+		}
+		if (newer->replace) {
+			obs_data_release(item.json);
+			continue;
+		}
+		newer->json = item.json;
+		newer->text = std::move(item.text);
+		newer->replace = item.replace;
+		newer->append.insert(0, item.append);
+		newer->attempts = item.attempts;
+	}
+	failed.clear();
+}
+
+void ZoominatorSettingsWriter::run()
+{
+	static constexpr int kMaxAttempts = 8;
+	static constexpr int kFirstRetryMs = 250;
+	static constexpr int kMaxRetryMs = 8000;
+
+	std::vector<Pending> batch;
+	std::vector<Pending> failed;
+	int retryMs = 0;
+
+	for (;;) {
+		bool finalPass = false;
+		{
+			std::unique_lock<std::mutex> lk(lock);
+			if (retryMs > 0)
+				wake.wait_for(lk, std::chrono::milliseconds(retryMs), [this]() { return stopping; });
+			wake.wait(lk, [this]() { return stopping || !pending.empty(); });
+			if (pending.empty() && stopping)
+				break;
+
+			batch.swap(pending);
+			finalPass = stopping;
+			writing = true;
+		}
+
+		for (Pending &item : batch) {
+			if (writeEntry(item)) {
+				writes.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			item.attempts++;
+			if (finalPass || item.attempts >= kMaxAttempts) {
+				blog(LOG_ERROR, "[Zoominator] Giving up on %s after %d failed write(s)", item.path.c_str(),
+				     item.attempts);
+				obs_data_release(item.json);
+				continue;
+			}
+			blog(LOG_WARNING, "[Zoominator] Failed to write %s (attempt %d), retrying", item.path.c_str(),
+			     item.attempts);
+			failed.push_back(std::move(item));
+		}
+		batch.clear();
+
+		retryMs = failed.empty() ? 0 : std::min(retryMs > 0 ? retryMs * 2 : kFirstRetryMs, kMaxRetryMs);
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			requeue(failed);
+			writing = false;
+		}
+		drained.notify_all();
+	}
+
+	drained.notify_all();
+}
+
+bool ZoominatorSettingsWriter::writeEntry(Pending &item)
+{
+	// Whatever succeeds is dropped from the entry, so a retry only redoes
+	// the part that failed.
+	if (item.json) {
+		const char *json = obs_data_get_json_pretty(item.json);
+		if (!json || !writeFile(item.path, json, strlen(json)))
+			return false;
+		obs_data_release(item.json);
+		item.json = nullptr;
+		item.replace = false;
+	} else if (item.replace) {
+		if (!writeFile(item.path, item.text.data(), item.text.size()))
+			return false;
+		item.text.clear();
+		item.replace = false;
+	}
+
+	if (!item.append.empty()) {
+		if (!appendFile(item.path, item.append.data(), item.append.size()))
+			return false;
+		item.append.clear();
+	}
+	return true;
+}
+
+static bool write_synced(const std::string &path, const char *mode, const char *bytes, size_t len)
+{
+	FILE *f = os_fopen(path.c_str(), mode);
+	if (!f)
+		return false;
+
+	bool ok = fwrite(bytes, 1, len, f) == len && fflush(f) == 0;
+#ifdef _WIN32
+	ok = ok && _commit(_fileno(f)) == 0;
+#else
+	ok = ok && fsync(fileno(f)) == 0;
+#endif
+	return fclose(f) == 0 && ok;
+}
+
+bool ZoominatorSettingsWriter::writeFile(const std::string &path, const char *bytes, size_t len)
+{
+	const size_t slash = path.find_last_of("/\\");
+	if (slash != std::string::npos)
+		os_mkdirs(path.substr(0, slash).c_str());
+
+	const std::string tmpPath = path + ".tmp";
+	const std::string bakPath = path + ".bak";
+
+	if (!write_synced(tmpPath, "wb", bytes, len)) {
+		os_unlink(tmpPath.c_str());
+		return false;
+	}
+
+	if (!os_file_exists(path.c_str()))
+		return os_rename(tmpPath.c_str(), path.c_str()) == 0;
+	return os_safe_replace(path.c_str(), tmpPath.c_str(), bakPath.c_str()) == 0;
+}
+
+bool ZoominatorSettingsWriter::appendFile(const std::string &path, const char *bytes, size_t len)
+{
+	return write_synced(path, "ab", bytes, len);
+}
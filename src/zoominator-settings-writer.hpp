@@ -0,0 +1,69 @@
+#pragma once
+
+#include <obs.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Background persistence for the plugin's config files. Callers hand over an
+// immutable snapshot and return immediately; the worker serializes it, writes
+// a temp file, fsyncs it and swaps it into place. Snapshots queued for the
+// same path while a write is in flight replace each other, so a burst of
+// saves costs a single write of the newest state. Appends are the exception:
+// they are concatenated in order and land after any pending replacement.
+//
+// Paths are written in the order of their latest submission, so a file
+// submitted after another (the recovery flag after the journal records it
+// guards) never reaches disk first. A failed write is re-queued ahead of
+// newer work, merged with anything submitted for the same path meanwhile,
+// and retried with exponential backoff before it is given up.
+class ZoominatorSettingsWriter final {
+public:
+	ZoominatorSettingsWriter() = default;
+	~ZoominatorSettingsWriter();
+	ZoominatorSettingsWriter(const ZoominatorSettingsWriter &) = delete;
+	ZoominatorSettingsWriter &operator=(const ZoominatorSettingsWriter &) = delete;
+
+	void start();
+	void stop();
+	void flush();
+
+	// Takes ownership of one reference to snapshot.
+	void submitJson(const std::string &path, obs_data_t *snapshot);
+	void submitText(const std::string &path, std::string text);
+	void submitAppend(const std::string &path, const std::string &bytes);
+
+	// Files successfully written since start-up; safe to read from any thread.
+	uint64_t writeCount() const { return writes.load(std::memory_order_relaxed); }
+
+private:
+	struct Pending {
+		std::string path;
+		obs_data_t *json = nullptr;
+		std::string text;
+		std::string append;
+		bool replace = false;
+		int attempts = 0;
+	};
+
+	Pending &slotFor(const std::string &path);
+	void requeue(std::vector<Pending> &failed);
+	void run();
+	bool writeEntry(Pending &item);
+	static bool writeFile(const std::string &path, const char *bytes, size_t len);
+	static bool appendFile(const std::string &path, const char *bytes, size_t len);
+
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable drained;
+	std::vector<Pending> pending; // oldest latest-submission first
+	std::thread worker;
+	bool running = false;
+	bool stopping = false;
+	bool writing = false;
+	std::atomic<uint64_t> writes{0};
+};
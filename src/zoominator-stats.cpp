@@ -0,0 +1,77 @@
+#include "zoominator-stats.hpp"
+
+#include <util/platform.h>
+
+#include <algorithm>
+#include <array>
+
+ZoominatorStats::TickScope::TickScope(ZoominatorStats &stats) : stats(stats), startNs(os_gettime_ns()) {}
+
+ZoominatorStats::TickScope::~TickScope()
+{
+	stats.recordTick(startNs, os_gettime_ns() - startNs);
+}
+
+void ZoominatorStats::recordTick(uint64_t startNs, uint64_t durationNs)
+{
+	const uint64_t head = tickHead.load(std::memory_order_relaxed);
+	const size_t slot = (size_t)(head % kTickWindow);
+	tickStartNs[slot].store(startNs, std::memory_order_relaxed);
+	tickDurationUs[slot].store((uint32_t)std::min<uint64_t>(durationNs / 1000, UINT32_MAX),
+				   std::memory_order_relaxed);
+	tickHead.store(head + 1, std::memory_order_release);
+}
+
+void ZoominatorStats::recordItems(uint32_t applied, uint32_t skipped)
+{
+	lastApplied.store(applied, std::memory_order_relaxed);
+	lastSkipped.store(skipped, std::memory_order_relaxed);
+	appliedTotal.fetch_add(applied, std::memory_order_relaxed);
+	skippedTotal.fetch_add(skipped, std::memory_order_relaxed);
+}
+
+void ZoominatorStats::recordFrameApplied(uint64_t ns)
+{
+	// Only the first frame after a trigger counts; later frames find the mark
+	// already cleared.
+	const uint64_t trigger = triggerNs.exchange(0, std::memory_order_relaxed);
+	if (trigger != 0 && ns >= trigger)
+		triggerLatencyNs.store((int64_t)(ns - trigger), std::memory_order_relaxed);
+}
+
+ZoominatorStatsSnapshot ZoominatorStats::snapshot(uint64_t nowNs) const
+{
+	ZoominatorStatsSnapshot s;
+	s.itemsApplied = lastApplied.load(std::memory_order_relaxed);
+	s.itemsSkipped = lastSkipped.load(std::memory_order_relaxed);
+	s.itemsAppliedTotal = appliedTotal.load(std::memory_order_relaxed);
+	s.itemsSkippedTotal = skippedTotal.load(std::memory_order_relaxed);
+	s.markerUpdates = markerUpdates.load(std::memory_order_relaxed);
+	const int64_t latency = triggerLatencyNs.load(std::memory_order_relaxed);
+	s.triggerLatencyMs = latency >= 0 ? (double)latency / 1e6 : -1.0;
+
+	const uint64_t head = tickHead.load(std::memory_order_acquire);
+	const size_t n = (size_t)std::min<uint64_t>(head, kTickWindow);
+	if (n == 0)
+		return s;
+
+	std::array<uint32_t, kTickWindow> durations{};
+	const uint64_t secondAgo = nowNs > 1000000000ull ? nowNs - 1000000000ull : 0;
+	int recent = 0;
+	for (size_t i = 0; i < n; i++) {
+		durations[i] = tickDurationUs[i].load(std::memory_order_relaxed);
+		if (tickStartNs[i].load(std::memory_order_relaxed) >= secondAgo)
+			recent++;
+	}
+	s.tickRateHz = (double)recent;
+
+	auto percentile = [&](double p) {
+		const size_t k = std::min(n - 1, (size_t)(p * (double)(n - 1) + 0.5));
+		std::nth_element(durations.begin(), durations.begin() + (ptrdiff_t)k, durations.begin() + (ptrdiff_t)n);
+		return (double)durations[k] / 1000.0;
+	};
+	s.tickP50Ms = percentile(0.50);
+	s.tickP95Ms = percentile(0.95);
+	s.tickP99Ms = percentile(0.99);
+	return s;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct ZoominatorStatsSnapshot {
+	double tickRateHz = 0.0; // ticks started during the last second
+	double tickP50Ms = 0.0;  // percentiles over the most recent ticks
+	double tickP95Ms = 0.0;
+	double tickP99Ms = 0.0;
+	uint32_t itemsApplied = 0; // last applied frame
+	uint32_t itemsSkipped = 0;
+	uint64_t itemsAppliedTotal = 0;
+	uint64_t itemsSkippedTotal = 0;
+	uint64_t markerUpdates = 0;
+	uint64_t settingsWrites = 0;
+	double triggerLatencyMs = -1.0; // trigger to first applied frame; < 0 until measured
+};
+
+// Runtime counters for the dialog's Performance tab. The controller publishes
+// from the UI thread with relaxed atomics and never blocks; readers copy the
+// recent-tick window and compute percentiles on their side, so a torn read
+// only ever skews one sample.
+class ZoominatorStats final {
+public:
+	// Times one onTick call, including early returns.
+	class TickScope final {
+	public:
+		explicit TickScope(ZoominatorStats &stats);
+		~TickScope();
+		TickScope(const TickScope &) = delete;
+		TickScope &operator=(const TickScope &) = delete;
+
+	private:
+		ZoominatorStats &stats;
+		uint64_t startNs;
+	};
+
+	void recordTick(uint64_t startNs, uint64_t durationNs);
+	void recordItems(uint32_t applied, uint32_t skipped);
+	void recordMarkerUpdate() { markerUpdates.fetch_add(1, std::memory_order_relaxed); }
+	void markTrigger(uint64_t ns) { triggerNs.store(ns, std::memory_order_relaxed); }
+	void recordFrameApplied(uint64_t ns);
+
+	ZoominatorStatsSnapshot snapshot(uint64_t nowNs) const;
+
+private:
+	static constexpr size_t kTickWindow = 256;
+
+	std::atomic<uint64_t> tickStartNs[kTickWindow] = {};
+	std::atomic<uint32_t> tickDurationUs[kTickWindow] = {};
+	std::atomic<uint64_t> tickHead{0};
+	std::atomic<uint32_t> lastApplied{0};
+	std::atomic<uint32_t> lastSkipped{0};
+	std::atomic<uint64_t> appliedTotal{0};
+	std::atomic<uint64_t> skippedTotal{0};
+	std::atomic<uint64_t> markerUpdates{0};
+	std::atomic<uint64_t> triggerNs{0};
+	std::atomic<int64_t> triggerLatencyNs{-1};
+};
@@ -0,0 +1,123 @@
+#include "zoominator-tick-plan.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Writes smaller than this are skipped; libobs would mark the item dirty for
+// a change no one can see.
+static constexpr float kApplyEpsilon = 0.01f;
+
+static bool nearly_equal(float a, float b)
+{
+	return std::fabs(a - b) <= kApplyEpsilon;
+}
+
+ZoominatorScreenMap ZoominatorScreenMap::fromRect(int x, int y, int w, int h, double canvasW, double canvasH)
+{
+	ZoominatorScreenMap m;
+	if (w <= 0 || h <= 0 || canvasW <= 0.0 || canvasH <= 0.0)
+		return m;
+	m.valid = true;
+	m.rectX = x;
+	m.rectY = y;
+	m.rectW = w;
+	m.rectH = h;
+	m.scaleX = canvasW / (double)w;
+	m.scaleY = canvasH / (double)h;
+	m.offsetX = -(double)x * m.scaleX;
+	m.offsetY = -(double)y * m.scaleY;
+	return m;
+}
+
+bool ZoominatorScreenMap::map(int cursorX, int cursorY, float &sceneX, float &sceneY, bool &inside) const
+{
+	inside = false;
+	sceneX = 0.0f;
+	sceneY = 0.0f;
+	if (!valid)
+		return false;
+
+	inside = !(cursorX < rectX || cursorX >= rectX + rectW || cursorY < rectY || cursorY >= rectY + rectH);
+	const int clampedX = std::max(rectX, std::min(cursorX, rectX + rectW - 1));
+	const int clampedY = std::max(rectY, std::min(cursorY, rectY + rectH - 1));
+	sceneX = (float)(clampedX * scaleX + offsetX);
+	sceneY = (float)(clampedY * scaleY + offsetY);
+	return true;
+}
+
+void ZoominatorTickPlanner::clear()
+{
+	items.clear();
+	batch.clear();
+	planned.clear();
+	appliedCount = 0;
+	skippedCount = 0;
+}
+
+void ZoominatorTickPlanner::add(const void *item, float effectivePosX, float effectivePosY, float effectiveScaleX,
+				float effectiveScaleY)
+{
+	Item entry;
+	entry.handle = item;
+	items.push_back(entry);
+	batch.push(effectivePosX, effectivePosY, effectiveScaleX, effectiveScaleY);
+
+	// Size the outputs now so the first plan() does not grow them.
+	const size_t n = items.size();
+	batch.outPosX.reserve(n);
+	batch.outPosY.reserve(n);
+	batch.outScaleX.reserve(n);
+	batch.outScaleY.reserve(n);
+	planned.reserve(n);
+}
+
+void ZoominatorTickPlanner::plan(const ZoominatorCamera &camera)
+{
+	planned.clear();
+	appliedCount = 0;
+	skippedCount = 0;
+	zoominator_camera_transform_items(camera, batch);
+
+	for (size_t i = 0; i < items.size(); i++) {
+		Item &item = items[i];
+		if (!item.handle || !item.live)
+			continue;
+
+		ZoominatorPlanOp op;
+		op.index = i;
+		op.posX = batch.outPosX[i];
+		op.posY = batch.outPosY[i];
+		op.scaleX = batch.outScaleX[i];
+		op.scaleY = batch.outScaleY[i];
+		op.normalize = !item.normalized;
+		item.normalized = true;
+
+		op.setScale = !item.lastValid || !nearly_equal(item.lastScaleX, op.scaleX) ||
+			      !nearly_equal(item.lastScaleY, op.scaleY);
+		if (op.setScale) {
+			item.lastScaleX = op.scaleX;
+			item.lastScaleY = op.scaleY;
+		}
+		op.setPos = !item.lastValid || !nearly_equal(item.lastPosX, op.posX) ||
+			    !nearly_equal(item.lastPosY, op.posY);
+		if (op.setPos) {
+			item.lastPosX = op.posX;
+			item.lastPosY = op.posY;
+		}
+		item.lastValid = true;
+
+		if (op.setPos || op.setScale)
+			appliedCount++;
+		else
+			skippedCount++;
+		if (op.setPos || op.setScale || op.normalize)
+			planned.push_back(op);
+	}
+}
+
+void ZoominatorTickPlanner::markerPoint(const ZoominatorCamera &camera, bool sceneSpace, float sceneX, float sceneY,
+					double &x, double &y)
+{
+	x = sceneSpace ? (double)sceneX : camera.mapX(sceneX);
+	y = sceneSpace ? (double)sceneY : camera.mapY(sceneY);
+}
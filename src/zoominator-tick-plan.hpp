@@ -0,0 +1,87 @@
+#pragma once
+
+#include "zoominator-camera.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The per-tick half of applyZoomToScene: cursor to scene mapping, the item
+// transforms for the current camera, the dirty checks against what was last
+// written, and the marker point. Free of libobs and Qt, so the steady-state
+// tick can be run under an allocation counter on its own; scene items are
+// opaque handles owned by the caller.
+
+// Selected screen rect folded into a cursor -> scene affine transform.
+struct ZoominatorScreenMap {
+	bool valid = false;
+	int rectX = 0;
+	int rectY = 0;
+	int rectW = 0;
+	int rectH = 0;
+	double scaleX = 0.0;
+	double scaleY = 0.0;
+	double offsetX = 0.0;
+	double offsetY = 0.0;
+
+	static ZoominatorScreenMap fromRect(int x, int y, int w, int h, double canvasW, double canvasH);
+
+	// Clamps the cursor to the rect; false only when no screen is selected.
+	bool map(int cursorX, int cursorY, float &sceneX, float &sceneY, bool &inside) const;
+};
+
+// One transform write for item index(), as decided by plan(). normalize is
+// set on an item's first write so the caller can clear bounds and force
+// top-left alignment where the item still has them.
+struct ZoominatorPlanOp {
+	size_t index = 0;
+	float posX = 0.0f;
+	float posY = 0.0f;
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	bool setPos = false;
+	bool setScale = false;
+	bool normalize = false;
+};
+
+class ZoominatorTickPlanner final {
+public:
+	// Capture time: every buffer the tick uses is sized here.
+	void clear();
+	void add(const void *item, float effectivePosX, float effectivePosY, float effectiveScaleX,
+		 float effectiveScaleY);
+	size_t size() const { return items.size(); }
+	const void *item(size_t i) const { return items[i].handle; }
+
+	// Items the caller no longer finds in the scene are skipped by plan().
+	void setLive(size_t i, bool live) { items[i].live = live; }
+
+	// Tick time: never allocates once add() has run for every item.
+	void plan(const ZoominatorCamera &camera);
+	const std::vector<ZoominatorPlanOp> &ops() const { return planned; }
+	uint32_t applied() const { return appliedCount; }
+	uint32_t skipped() const { return skippedCount; }
+
+	// Where the cursor marker goes for a scene point: through the camera on the
+	// canvas, or unchanged when it is drawn in scene space under the filter.
+	static void markerPoint(const ZoominatorCamera &camera, bool sceneSpace, float sceneX, float sceneY,
+				double &x, double &y);
+
+private:
+	struct Item {
+		const void *handle = nullptr;
+		bool live = true;
+		bool normalized = false;
+		bool lastValid = false;
+		float lastPosX = 0.0f;
+		float lastPosY = 0.0f;
+		float lastScaleX = 0.0f;
+		float lastScaleY = 0.0f;
+	};
+
+	std::vector<Item> items;
+	ZoominatorItemBatch batch;
+	std::vector<ZoominatorPlanOp> planned;
+	uint32_t appliedCount = 0;
+	uint32_t skippedCount = 0;
+};
@@ -0,0 +1,91 @@
+#include "zoominator-tick-profiler.hpp"
+
+#include <obs.h>
+#include <util/platform.h>
+#include <util/profiler.h>
+
+// The OBS profiler keys scopes by name pointer, so these must stay static.
+static const char *const kPhaseNames[] = {
+	"zoominator_tick", "capture", "cursor_map", "follow", "transform", "marker", "settings_save",
+};
+static_assert(sizeof(kPhaseNames) / sizeof(kPhaseNames[0]) == (size_t)ZoominatorTickPhase::Count,
+	      "every tick phase needs a profiler name");
+
+ZoominatorTickProfiler::Scope::Scope(ZoominatorTickProfiler &profiler, ZoominatorTickPhase phase)
+	: profiler(profiler),
+	  phase(phase),
+	  obsScope(profiler.obsScopes()),
+	  startNs(os_gettime_ns())
+{
+	if (obsScope)
+		profile_start(phaseName(phase));
+}
+
+ZoominatorTickProfiler::Scope::~Scope()
+{
+	if (obsScope)
+		profile_end(phaseName(phase));
+	profiler.add(phase, os_gettime_ns() - startNs);
+}
+
+const char *ZoominatorTickProfiler::phaseName(ZoominatorTickPhase phase)
+{
+	const size_t i = (size_t)phase;
+	return i < (size_t)ZoominatorTickPhase::Count ? kPhaseNames[i] : "unknown";
+}
+
+void ZoominatorTickProfiler::setObsScopes(bool enabled)
+{
+	obsScopesEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ZoominatorTickProfiler::obsScopes() const
+{
+	return obsScopesEnabled.load(std::memory_order_relaxed);
+}
+
+void ZoominatorTickProfiler::add(ZoominatorTickPhase phase, uint64_t ns)
+{
+	const size_t i = (size_t)phase;
+	if (i >= (size_t)ZoominatorTickPhase::Count)
+		return;
+	counters[i].ns.fetch_add(ns, std::memory_order_relaxed);
+	counters[i].count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t ZoominatorTickProfiler::totalNs(ZoominatorTickPhase phase) const
+{
+	const size_t i = (size_t)phase;
+	return i < (size_t)ZoominatorTickPhase::Count ? counters[i].ns.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t ZoominatorTickProfiler::count(ZoominatorTickPhase phase) const
+{
+	const size_t i = (size_t)phase;
+	return i < (size_t)ZoominatorTickPhase::Count ? counters[i].count.load(std::memory_order_relaxed) : 0;
+}
+
+void ZoominatorTickProfiler::log() const
+{
+	const uint64_t ticks = count(ZoominatorTickPhase::Tick);
+	const uint64_t tickNs = totalNs(ZoominatorTickPhase::Tick);
+	blog(LOG_INFO, "[Zoominator] Tick profile: %llu tick(s), %.3f ms total, %.1f us/tick.",
+	     (unsigned long long)ticks, (double)tickNs / 1e6, ticks ? (double)tickNs / 1e3 / (double)ticks : 0.0);
+
+	for (size_t i = 1; i < (size_t)ZoominatorTickPhase::Count; i++) {
+		const auto phase = (ZoominatorTickPhase)i;
+		const uint64_t n = count(phase);
+		const uint64_t ns = totalNs(phase);
+		blog(LOG_INFO, "[Zoominator]   %-13s %8llu call(s) %10.3f ms %8.1f us/call %5.1f%%", phaseName(phase),
+		     (unsigned long long)n, (double)ns / 1e6, n ? (double)ns / 1e3 / (double)n : 0.0,
+		     tickNs ? (double)ns * 100.0 / (double)tickNs : 0.0);
+	}
+}
+
+void ZoominatorTickProfiler::reset()
+{
+	for (Counter &counter : counters) {
+		counter.ns.store(0, std::memory_order_relaxed);
+		counter.count.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class ZoominatorTickPhase : uint8_t {
+	Tick,
+	Capture,
+	CursorMap,
+	Follow,
+	Transform,
+	Marker,
+	SettingsSave,
+	Count,
+};
+
+// Where onTick spends its time. Wall time per phase always goes into atomic
+// totals that log() prints on demand; they cost two clock reads and two relaxed
+// adds per scope. With setObsScopes(true) each phase is also an OBS profiler
+// scope under "zoominator_tick" in the dump OBS writes on exit. That is off by
+// default because profile_start/profile_end take the profiler's lock and may
+// allocate, which the steady-state tick otherwise avoids. Totals are inclusive:
+// a phase nested in another counts in both.
+class ZoominatorTickProfiler final {
+public:
+	class Scope final {
+	public:
+		Scope(ZoominatorTickProfiler &profiler, ZoominatorTickPhase phase);
+		~Scope();
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		ZoominatorTickProfiler &profiler;
+		ZoominatorTickPhase phase;
+		bool obsScope;
+		uint64_t startNs;
+	};
+
+	static const char *phaseName(ZoominatorTickPhase phase);
+
+	// Takes effect for scopes opened after the call.
+	void setObsScopes(bool enabled);
+	bool obsScopes() const;
+
+	void add(ZoominatorTickPhase phase, uint64_t ns);
+	uint64_t totalNs(ZoominatorTickPhase phase) const;
+	uint64_t count(ZoominatorTickPhase phase) const;
+	void log() const;
+	void reset();
+
+private:
+	struct Counter {
+		std::atomic<uint64_t> ns{0};
+		std::atomic<uint64_t> count{0};
+	};
+
+	Counter counters[(size_t)ZoominatorTickPhase::Count];
+	std::atomic<bool> obsScopesEnabled{false};
+};
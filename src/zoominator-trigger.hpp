@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+// Modifier keys as bits so a whole keyboard modifier state fits in one byte.
+// Each family occupies a left/right pair of adjacent bits.
+enum : uint8_t {
+	kZoominatorModLeftCtrl = 1 << 0,
+	kZoominatorModRightCtrl = 1 << 1,
+	kZoominatorModLeftAlt = 1 << 2,
+	kZoominatorModRightAlt = 1 << 3,
+	kZoominatorModLeftShift = 1 << 4,
+	kZoominatorModRightShift = 1 << 5,
+	kZoominatorModLeftWin = 1 << 6,
+	kZoominatorModRightWin = 1 << 7,
+};
+
+enum ZoominatorModFamily { kZoominatorModCtrl = 0, kZoominatorModAlt = 1, kZoominatorModShift = 2, kZoominatorModWin = 3 };
+
+// Modifier requirement compiled from the per-family any/left/right settings.
+// "Any" accepts either side, left/right demand that side, and a family with
+// nothing wanted must be fully released.
+struct ZoominatorModifierMatch {
+	uint8_t required = 0;
+	uint8_t forbidden = 0;
+	uint8_t anyOf = 0;  // low bit of each pair where either side satisfies the family
+	uint8_t wanted = 0; // modifier keys that take part in the match at all
+
+	void want(ZoominatorModFamily family, bool any, bool left, bool right)
+	{
+		const uint8_t l = (uint8_t)(1u << (family * 2));
+		const uint8_t r = (uint8_t)(l << 1);
+		if (left)
+			required |= l;
+		if (right)
+			required |= r;
+		if (any) {
+			anyOf |= l;
+			wanted |= l | r;
+		} else {
+			if (!left)
+				forbidden |= l;
+			if (!right)
+				forbidden |= r;
+		}
+		if (left)
+			wanted |= l;
+		if (right)
+			wanted |= r;
+	}
+
+	bool matches(uint8_t state) const
+	{
+		const uint8_t pairs = (uint8_t)((state | (state >> 1)) & 0x55);
+		return (state & required) == required && (state & forbidden) == 0 && (pairs & anyOf) == anyOf;
+	}
+};
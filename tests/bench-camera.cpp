@@ -0,0 +1,72 @@
+#include "zoominator-camera.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Times zoominator_camera_transform_items() against a plain scalar loop over
+// the same structure-of-arrays batch. Usage: zoominator-bench-camera [iterations]
+
+static void scalar_transform(const ZoominatorCamera &camera, ZoominatorItemBatch &batch)
+{
+	const size_t n = batch.size();
+	batch.outPosX.resize(n);
+	batch.outPosY.resize(n);
+	batch.outScaleX.resize(n);
+	batch.outScaleY.resize(n);
+
+	const float z = (float)camera.zoom;
+	const float tx = (float)camera.translateX();
+	const float ty = (float)camera.translateY();
+	for (size_t i = 0; i < n; i++) {
+		batch.outPosX[i] = batch.posX[i] * z + tx;
+		batch.outPosY[i] = batch.posY[i] * z + ty;
+		batch.outScaleX[i] = batch.scaleX[i] * z;
+		batch.outScaleY[i] = batch.scaleY[i] * z;
+	}
+}
+
+template<typename Fn> static double time_ns_per_item(Fn fn, ZoominatorItemBatch &batch, int iterations)
+{
+	ZoominatorCamera camera;
+	camera.anchorX = 960.0;
+	camera.anchorY = 540.0;
+
+	volatile float sink = 0.0f;
+	const auto start = std::chrono::steady_clock::now();
+	for (int it = 0; it < iterations; it++) {
+		camera.zoom = 1.0 + (double)(it % 100) * 0.01;
+		camera.focusX = (double)(it % 1920);
+		camera.focusY = (double)(it % 1080);
+		fn(camera, batch);
+		sink = sink + batch.outPosX[(size_t)it % batch.size()];
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	(void)sink;
+	const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	return ns / ((double)iterations * (double)batch.size());
+}
+
+int main(int argc, char **argv)
+{
+	const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> pos(-4000.0f, 4000.0f);
+	std::uniform_real_distribution<float> scale(0.01f, 8.0f);
+
+	std::printf("%8s %14s %14s %8s\n", "items", "kernel ns/item", "scalar ns/item", "speedup");
+	for (size_t n : {8, 64, 500, 5000, 50000}) {
+		ZoominatorItemBatch batch;
+		for (size_t i = 0; i < n; i++)
+			batch.push(pos(rng), pos(rng), scale(rng), scale(rng));
+
+		// Keep the total work per row roughly constant.
+		const int iters = (int)std::max<size_t>(1, (size_t)iterations * 64 / n);
+		const double kernel = time_ns_per_item(zoominator_camera_transform_items, batch, iters);
+		const double scalar = time_ns_per_item(scalar_transform, batch, iters);
+		std::printf("%8zu %14.3f %14.3f %7.2fx\n", n, kernel, scalar, kernel > 0.0 ? scalar / kernel : 0.0);
+	}
+	return 0;
+}
@@ -0,0 +1,263 @@
+#include "zoominator-recovery-index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Times the lookups of the crash-recovery restore pass on a 50-scene /
+// 5,000-item collection through ZoominatorRecoveryIndex, the index the
+// controller builds in rebuildRecoveryIndex() and queries from
+// restoreRecoveryIfNeeded(). Only the OBS scene walk is modelled; both the
+// UUID keys and the legacy name keys go through the shipping code. The
+// pre-index legacy prefix scan is kept as the baseline.
+// Usage: zoominator-bench-recovery-restore [passes]
+
+namespace {
+
+struct Item {
+	std::string source;
+	uint8_t sourceTag = 0;
+	int64_t id = 0;
+	int nestedScene = -1;
+};
+
+struct Scene {
+	std::string name;
+	std::vector<Item> items;
+};
+
+struct Collection {
+	std::vector<Scene> scenes;
+	std::vector<int> topLevel;
+	size_t itemCount = 0;
+};
+
+static constexpr int kScenes = 50;
+static constexpr int kGroupScenes = 10;
+static constexpr int kItemsPerScene = 100;
+static constexpr int kZoomedScenes = 2;
+
+struct KeyHash {
+	size_t operator()(const ZoominatorSceneItemKey &key) const noexcept { return key.hash(); }
+};
+
+using RecoveryMap = std::unordered_map<ZoominatorSceneItemKey, int, KeyHash>;
+using LegacyRecoveryMap = std::unordered_map<std::string, int>;
+
+static ZoominatorSceneItemKey item_key(int scene, const Item &item, int64_t id)
+{
+	ZoominatorSceneItemKey key;
+	for (int i = 0; i < 16; i++) {
+		key.scene[i] = (uint8_t)(scene * 7 + i);
+		key.source[i] = (uint8_t)(item.sourceTag + scene * 13 + i);
+	}
+	key.itemId = id;
+	return key;
+}
+
+static std::string legacy_key(const std::string &scene, const std::string &source, int64_t id)
+{
+	return scene + "::" + source + "::" + std::to_string(id);
+}
+
+// 40 top-level scenes of 98 sources each also reference two of the 10 group
+// scenes, so a naive walk visits each group scene once per reference.
+static Collection build_collection()
+{
+	Collection c;
+	c.scenes.resize(kScenes);
+	int64_t nextId = 1;
+	for (int s = 0; s < kScenes; s++) {
+		Scene &scene = c.scenes[s];
+		scene.name = "Scene " + std::to_string(s);
+		const bool group = s >= kScenes - kGroupScenes;
+		const int sources = group ? kItemsPerScene : kItemsPerScene - 2;
+		for (int i = 0; i < sources; i++)
+			scene.items.push_back(
+				{"Source " + std::to_string(s) + "." + std::to_string(i), (uint8_t)i, nextId++, -1});
+		if (!group) {
+			for (int g = 0; g < 2; g++) {
+				const int nested = kScenes - kGroupScenes + (s + g * 3) % kGroupScenes;
+				scene.items.push_back({"", (uint8_t)(200 + g), nextId++, nested});
+			}
+		}
+		c.itemCount += scene.items.size();
+	}
+	for (int s = 0; s < kScenes; s++)
+		c.topLevel.push_back(s);
+	for (int s = 0; s < kScenes; s++)
+		for (Item &item : c.scenes[s].items)
+			if (item.nestedScene >= 0)
+				item.source = c.scenes[item.nestedScene].name;
+	return c;
+}
+
+// Recovery state as left by a crash while the first scenes were zoomed.
+// Every tenth item was recreated under a new id, so only the lone
+// scene/source fallback can match it.
+template<typename Fn> static void for_each_crashed_item(const Collection &c, Fn fn)
+{
+	for (int s = 0; s < kZoomedScenes; s++) {
+		const Scene &scene = c.scenes[s];
+		for (size_t i = 0; i < scene.items.size(); i++) {
+			const Item &item = scene.items[i];
+			fn(s, item, i % 10 == 0 ? item.id + 1000000 : item.id, (int)i);
+		}
+	}
+}
+
+static bool starts_with(const std::string &s, const std::string &prefix)
+{
+	return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Before: exact key lookup, and on a miss a scan of every recovery key for a
+// unique "scene::source::" prefix; nested scenes re-walked per reference.
+static int restore_before_scene(const Collection &c, const LegacyRecoveryMap &recovery, int s)
+{
+	int restored = 0;
+	const Scene &scene = c.scenes[s];
+	for (const Item &item : scene.items) {
+		if (recovery.count(legacy_key(scene.name, item.source, item.id))) {
+			restored++;
+		} else {
+			const std::string prefix = scene.name + "::" + item.source + "::";
+			const std::string *matched = nullptr;
+			bool ambiguous = false;
+			for (const auto &entry : recovery) {
+				if (!starts_with(entry.first, prefix))
+					continue;
+				if (matched) {
+					ambiguous = true;
+					break;
+				}
+				matched = &entry.first;
+			}
+			if (matched && !ambiguous)
+				restored++;
+		}
+		if (item.nestedScene >= 0)
+			restored += restore_before_scene(c, recovery, item.nestedScene);
+	}
+	return restored;
+}
+
+static int restore_before(const Collection &c, const LegacyRecoveryMap &recovery)
+{
+	int restored = 0;
+	for (int s : c.topLevel)
+		restored += restore_before_scene(c, recovery, s);
+	return restored;
+}
+
+static void build_index(ZoominatorRecoveryIndex &index, const RecoveryMap &recovery,
+			const LegacyRecoveryMap &legacy)
+{
+	index.clear();
+	for (const auto &entry : recovery)
+		index.add(entry.first);
+	for (const auto &entry : legacy)
+		index.addLegacy(entry.first);
+}
+
+// The same walk as restoreRecoveryIfNeeded(): every scene once, UUID key
+// first, legacy name key only when legacy entries exist.
+static int restore_after(const Collection &c, const ZoominatorRecoveryIndex &index, const RecoveryMap &recovery,
+			 const LegacyRecoveryMap &legacy)
+{
+	int restored = 0;
+	std::unordered_set<int> visited;
+	std::vector<int> pending(c.topLevel.rbegin(), c.topLevel.rend());
+	std::string legacyPrefix;
+	std::string legacyPair;
+	while (!pending.empty()) {
+		const int s = pending.back();
+		pending.pop_back();
+		if (!visited.insert(s).second)
+			continue;
+		const Scene &scene = c.scenes[s];
+		legacyPrefix.clear();
+		if (!legacy.empty())
+			legacyPrefix.assign(scene.name).append("::");
+		for (const Item &item : scene.items) {
+			bool found = false;
+			if (const ZoominatorSceneItemKey *hit = index.resolve(item_key(s, item, item.id)))
+				found = recovery.count(*hit) != 0;
+			if (!found && !legacyPrefix.empty()) {
+				legacyPair.assign(legacyPrefix).append(item.source);
+				if (const std::string *hit = index.resolveLegacy(legacyPair, item.id))
+					found = legacy.count(*hit) != 0;
+			}
+			if (found)
+				restored++;
+			if (item.nestedScene >= 0)
+				pending.push_back(item.nestedScene);
+		}
+	}
+	return restored;
+}
+
+template<typename Fn> static double time_us(Fn fn, int passes, int &result)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < passes; i++)
+		result = fn();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 1e3 / passes;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	const int passes = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+
+	const Collection collection = build_collection();
+	RecoveryMap recovery;
+	LegacyRecoveryMap legacy;
+	for_each_crashed_item(collection, [&](int s, const Item &item, int64_t id, int i) {
+		recovery.emplace(item_key(s, item, id), i);
+		legacy.emplace(legacy_key(collection.scenes[s].name, item.source, id), i);
+	});
+	const RecoveryMap noRecovery;
+	const LegacyRecoveryMap noLegacy;
+
+	int before = 0;
+	int uuidRestored = 0;
+	int legacyRestored = 0;
+	int unused = 0;
+	const double beforeUs = time_us([&]() { return restore_before(collection, legacy); }, passes, before);
+
+	ZoominatorRecoveryIndex uuidIndex;
+	const double uuidIndexUs = time_us([&]() { return (build_index(uuidIndex, recovery, noLegacy), 0); },
+					   passes, unused);
+	const double uuidUs = time_us([&]() { return restore_after(collection, uuidIndex, recovery, noLegacy); },
+				      passes, uuidRestored);
+
+	ZoominatorRecoveryIndex legacyIndex;
+	const double legacyIndexUs = time_us([&]() { return (build_index(legacyIndex, noRecovery, legacy), 0); },
+					     passes, unused);
+	const double legacyUs = time_us(
+		[&]() { return restore_after(collection, legacyIndex, noRecovery, legacy); }, passes, legacyRestored);
+
+	std::printf("collection: %d scenes, %zu items, %zu recovery entries\n", kScenes, collection.itemCount,
+		    recovery.size());
+	std::printf("before (legacy scan): %10.1f us/pass, %d item(s) restored\n", beforeUs, before);
+	std::printf("index, uuid keys:     %10.1f us/pass + %.1f us index build, %d item(s) restored\n", uuidUs,
+		    uuidIndexUs, uuidRestored);
+	std::printf("index, legacy keys:   %10.1f us/pass + %.1f us index build, %d item(s) restored\n", legacyUs,
+		    legacyIndexUs, legacyRestored);
+	std::printf("speedup per pass: %.1fx (uuid), %.1fx (legacy)\n",
+		    uuidUs + uuidIndexUs > 0.0 ? beforeUs / (uuidUs + uuidIndexUs) : 0.0,
+		    legacyUs + legacyIndexUs > 0.0 ? beforeUs / (legacyUs + legacyIndexUs) : 0.0);
+	// The old startup also ran up to five passes (0/750/2000 ms timers plus
+	// two per FINISHED_LOADING); the new one runs one.
+	std::printf("startup: before %.1f ms (5 passes), after %.1f ms (1 pass)\n", beforeUs * 5.0 / 1e3,
+		    (uuidUs + uuidIndexUs) / 1e3);
+	return uuidRestored == legacyRestored && uuidRestored == before ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include "zoominator-alloc-guard.hpp"
+#include "zoominator-camera.hpp"
+#include "zoominator-ring-buffer.hpp"
+#include "zoominator-test.hpp"
+#include "zoominator-tick-plan.hpp"
+
+#include <memory>
+#include <vector>
+
+// Links zoominator-alloc-guard.cpp, so the counting operator new replaces the
+// global one in this executable.
+
+ZOOMINATOR_TEST(guard_counts_heap_allocations)
+{
+	ZoominatorAllocScope scope;
+	CHECK(scope.count() == 0);
+
+	auto one = std::make_unique<int>(7);
+	CHECK(scope.count() == 1);
+
+	std::vector<int> many(64);
+	CHECK(scope.count() == 2);
+
+	auto aligned = std::make_unique<std::max_align_t[]>(4);
+	CHECK(scope.count() == 3);
+}
+
+// The libobs-free part of applyZoomToScene for one zoomed-in tick: map the
+// cursor, aim the camera at it, clamp, plan the item writes and place the
+// marker.
+static size_t steady_tick(ZoominatorTickPlanner &planner, const ZoominatorScreenMap &screen, int cursorX,
+			  int cursorY, double &markerX, double &markerY)
+{
+	float sx = 0.0f, sy = 0.0f;
+	bool inside = false;
+	if (!screen.map(cursorX, cursorY, sx, sy, inside))
+		return 0;
+
+	ZoominatorCamera camera;
+	camera.zoom = zoominator_camera_zoom_at(1.0, 2.0);
+	camera.anchorX = sx;
+	camera.anchorY = sy;
+	camera.focusX = sx;
+	camera.focusY = sy;
+	const ZoominatorBounds content{0.0, 0.0, 1920.0, 1080.0};
+	zoominator_camera_clamp_offset(camera, content, 1920.0, 1080.0);
+
+	planner.plan(camera);
+	ZoominatorTickPlanner::markerPoint(camera, false, sx, sy, markerX, markerY);
+	return planner.ops().size();
+}
+
+ZOOMINATOR_TEST(steady_state_tick_is_allocation_free)
+{
+	const ZoominatorScreenMap screen = ZoominatorScreenMap::fromRect(0, 0, 2560, 1440, 1920.0, 1080.0);
+	int handles[300];
+	ZoominatorTickPlanner planner;
+	for (int i = 0; i < 300; i++)
+		planner.add(&handles[i], (float)(i % 20) * 96.0f, (float)(i / 20) * 72.0f, 0.25f, 0.25f);
+
+	// The first tick writes every item; that is the zoom start, not steady state.
+	double mx = 0.0, my = 0.0;
+	CHECK(steady_tick(planner, screen, 100, 100, mx, my) == 300);
+	planner.setLive(17, false);
+
+	size_t written = 0;
+	ZoominatorAllocScope scope;
+	for (int tick = 0; tick < 600; tick++) {
+		// Cursor sweeps, holds still, and leaves the screen.
+		const int x = tick < 200 ? 100 + tick * 9 : tick < 400 ? 1900 : 3000;
+		const int y = tick < 200 ? 100 + tick * 5 : tick < 400 ? 1100 : -50;
+		written += steady_tick(planner, screen, x, y, mx, my);
+	}
+	CHECK(scope.count() == 0);
+
+	// Moving ticks wrote items, and the still stretch wrote nothing.
+	CHECK(written > 0);
+	CHECK(steady_tick(planner, screen, 3000, -50, mx, my) == 0);
+	CHECK(planner.skipped() == 299);
+}
+
+ZOOMINATOR_TEST(input_ring_is_allocation_free)
+{
+	struct Event {
+		int kind;
+		double x;
+		double y;
+	};
+	auto ring = std::make_unique<ZoominatorSpscRing<Event, 256>>();
+
+	ZoominatorAllocScope scope;
+	for (int i = 0; i < 1000; i++) {
+		CHECK(ring->push({i, (double)i, (double)-i}));
+		Event e{};
+		CHECK(ring->pop(e));
+		CHECK(e.kind == i);
+	}
+	CHECK(scope.count() == 0);
+}
+
+ZOOMINATOR_TEST_MAIN()
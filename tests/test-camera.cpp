@@ -0,0 +1,322 @@
+#include "zoominator-camera.hpp"
+#include "zoominator-test.hpp"
+
+#include <algorithm>
+#include <random>
+
+ZOOMINATOR_TEST(smoothstep_clamps_and_eases)
+{
+	CHECK(zoominator_camera_smoothstep(-1.0) == 0.0);
+	CHECK(zoominator_camera_smoothstep(0.0) == 0.0);
+	CHECK(zoominator_camera_smoothstep(1.0) == 1.0);
+	CHECK(zoominator_camera_smoothstep(2.0) == 1.0);
+	CHECK_NEAR(zoominator_camera_smoothstep(0.5), 0.5, 1e-12);
+	CHECK_NEAR(zoominator_camera_smoothstep(0.25), 0.15625, 1e-12);
+	CHECK_NEAR(zoominator_camera_smoothstep(0.75), 0.84375, 1e-12);
+}
+
+ZOOMINATOR_TEST(zoom_at_follows_the_easing_curve)
+{
+	CHECK(zoominator_camera_zoom_at(0.0, 2.0) == 1.0);
+	CHECK(zoominator_camera_zoom_at(1.0, 2.0) == 2.0);
+	CHECK_NEAR(zoominator_camera_zoom_at(0.5, 3.0), 2.0, 1e-12);
+	CHECK_NEAR(zoominator_camera_zoom_at(0.25, 3.0), 1.3125, 1e-12);
+
+	// Factors at or below 1 never zoom out.
+	CHECK(zoominator_camera_zoom_at(0.5, 1.0) == 1.0);
+	CHECK(zoominator_camera_zoom_at(1.0, 0.5) == 1.0);
+}
+
+ZOOMINATOR_TEST(camera_maps_focus_onto_anchor)
+{
+	ZoominatorCamera camera;
+	camera.zoom = 2.0;
+	camera.anchorX = 960.0;
+	camera.anchorY = 540.0;
+	camera.focusX = 100.0;
+	camera.focusY = 50.0;
+
+	CHECK(camera.mapX(100.0) == 960.0);
+	CHECK(camera.mapY(50.0) == 540.0);
+	CHECK(camera.mapX(110.0) == 980.0);
+	CHECK(camera.mapY(40.0) == 520.0);
+
+	camera.offsetX = 5.0;
+	camera.offsetY = -3.0;
+	CHECK(camera.mapX(100.0) == 965.0);
+	CHECK(camera.mapY(50.0) == 537.0);
+	CHECK(camera.translateX() == 765.0);
+	CHECK(camera.translateY() == 437.0);
+	for (double p : {-300.0, 0.0, 12.5, 1919.0}) {
+		CHECK_NEAR(camera.mapX(p), p * camera.zoom + camera.translateX(), 1e-9);
+		CHECK_NEAR(camera.mapY(p), p * camera.zoom + camera.translateY(), 1e-9);
+	}
+}
+
+ZOOMINATOR_TEST(clamp_offset_keeps_the_canvas_covered)
+{
+	const ZoominatorBounds content{0.0, 0.0, 1920.0, 1080.0};
+
+	// Focus near the top-left corner would expose the canvas edge; the
+	// offset pulls the content back flush with it.
+	ZoominatorCamera camera;
+	camera.zoom = 2.0;
+	camera.anchorX = 960.0;
+	camera.anchorY = 540.0;
+	camera.focusX = 100.0;
+	camera.focusY = 100.0;
+	camera.offsetX = 123.0;
+	camera.offsetY = -45.0;
+	zoominator_camera_clamp_offset(camera, content, 1920.0, 1080.0);
+	CHECK(camera.offsetX == -760.0);
+	CHECK(camera.offsetY == -340.0);
+	CHECK(camera.mapX(content.minX) == 0.0);
+	CHECK(camera.mapY(content.minY) == 0.0);
+
+	// Same near the bottom-right corner.
+	camera.focusX = 1900.0;
+	camera.focusY = 1070.0;
+	zoominator_camera_clamp_offset(camera, content, 1920.0, 1080.0);
+	CHECK(camera.mapX(content.maxX) == 1920.0);
+	CHECK(camera.mapY(content.maxY) == 1080.0);
+
+	// A centred focus needs no correction.
+	camera.focusX = 960.0;
+	camera.focusY = 540.0;
+	zoominator_camera_clamp_offset(camera, content, 1920.0, 1080.0);
+	CHECK(camera.offsetX == 0.0);
+	CHECK(camera.offsetY == 0.0);
+}
+
+ZOOMINATOR_TEST(clamp_offset_centres_content_smaller_than_the_canvas)
+{
+	ZoominatorCamera camera;
+	const ZoominatorBounds content{0.0, 0.0, 960.0, 1080.0};
+	zoominator_camera_clamp_offset(camera, content, 1920.0, 1080.0);
+	CHECK(camera.offsetX == 480.0);
+	CHECK(camera.offsetY == 0.0);
+	CHECK(camera.mapX(content.minX) == 480.0);
+	CHECK(camera.mapX(content.maxX) == 1440.0);
+}
+
+ZOOMINATOR_TEST(effective_transform_resolves_alignment)
+{
+	ZoominatorItemGeometry g;
+	g.posX = 10.0f;
+	g.posY = 20.0f;
+	g.scaleX = 2.0f;
+	g.scaleY = 3.0f;
+	g.visibleW = 100.0f;
+	g.visibleH = 50.0f;
+
+	ZoominatorEffectiveTransform t = zoominator_camera_effective_transform(g);
+	CHECK(t.width == 200.0f);
+	CHECK(t.height == 150.0f);
+	CHECK(t.scaleX == 2.0f);
+	CHECK(t.scaleY == 3.0f);
+	CHECK(t.posX == 10.0f);
+	CHECK(t.posY == 20.0f);
+
+	g.alignX = 0;
+	g.alignY = 0;
+	t = zoominator_camera_effective_transform(g);
+	CHECK(t.posX == -90.0f);
+	CHECK(t.posY == -55.0f);
+
+	g.alignX = 1;
+	g.alignY = 1;
+	t = zoominator_camera_effective_transform(g);
+	CHECK(t.posX == -190.0f);
+	CHECK(t.posY == -130.0f);
+}
+
+ZOOMINATOR_TEST(effective_transform_uses_bounds)
+{
+	ZoominatorItemGeometry g;
+	g.scaleX = 2.0f;
+	g.scaleY = 2.0f;
+	g.visibleW = 100.0f;
+	g.visibleH = 50.0f;
+	g.useBounds = true;
+	g.boundsW = 400.0f;
+	g.boundsH = 100.0f;
+
+	ZoominatorEffectiveTransform t = zoominator_camera_effective_transform(g);
+	CHECK(t.width == 400.0f);
+	CHECK(t.height == 100.0f);
+	CHECK(t.scaleX == 4.0f);
+	CHECK(t.scaleY == 2.0f);
+
+	// Degenerate bounds fall back to the item scale.
+	g.boundsH = 0.0f;
+	t = zoominator_camera_effective_transform(g);
+	CHECK(t.width == 200.0f);
+	CHECK(t.height == 100.0f);
+
+	// An unsized source is treated as 1x1 rather than dividing by zero.
+	g.useBounds = false;
+	g.visibleW = 0.0f;
+	t = zoominator_camera_effective_transform(g);
+	CHECK(t.width == 2.0f);
+	CHECK(t.scaleX == 2.0f);
+}
+
+static ZoominatorCamera test_camera()
+{
+	ZoominatorCamera camera;
+	camera.zoom = 1.75;
+	camera.anchorX = 960.0;
+	camera.anchorY = 540.0;
+	camera.focusX = 311.25;
+	camera.focusY = 702.5;
+	camera.offsetX = -12.0;
+	camera.offsetY = 33.0;
+	return camera;
+}
+
+static bool same_float(float a, float b)
+{
+	// The vector and scalar paths both round a*z then +t; allow for a
+	// compiler contracting either side into an FMA.
+	return std::fabs(a - b) <= 1e-6f * std::max(1.0f, std::fabs(b));
+}
+
+ZOOMINATOR_TEST(transform_kernel_matches_scalar_reference)
+{
+	const ZoominatorCamera camera = test_camera();
+	const float z = (float)camera.zoom;
+	const float tx = (float)camera.translateX();
+	const float ty = (float)camera.translateY();
+
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> pos(-4000.0f, 4000.0f);
+	std::uniform_real_distribution<float> scale(0.01f, 8.0f);
+
+	ZoominatorItemBatch batch;
+	// Every remainder of n % 4, plus a large batch, so the scalar tail runs
+	// after a vector body as well as on its own.
+	for (size_t n : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 1027}) {
+		batch.clear();
+		for (size_t i = 0; i < n; i++)
+			batch.push(pos(rng), pos(rng), scale(rng), scale(rng));
+		zoominator_camera_transform_items(camera, batch);
+
+		CHECK(batch.size() == n);
+		CHECK(batch.outPosX.size() == n);
+		CHECK(batch.outPosY.size() == n);
+		CHECK(batch.outScaleX.size() == n);
+		CHECK(batch.outScaleY.size() == n);
+		for (size_t i = 0; i < n; i++) {
+			CHECK(same_float(batch.outPosX[i], batch.posX[i] * z + tx));
+			CHECK(same_float(batch.outPosY[i], batch.posY[i] * z + ty));
+			CHECK(same_float(batch.outScaleX[i], batch.scaleX[i] * z));
+			CHECK(same_float(batch.outScaleY[i], batch.scaleY[i] * z));
+		}
+	}
+}
+
+ZOOMINATOR_TEST(transform_kernel_vector_body_equals_scalar_tail)
+{
+	// Items 0..2 of a 7-item batch go through the vector body; the same
+	// values in a 3-item batch go through the scalar tail only.
+	const ZoominatorCamera camera = test_camera();
+	const float values[][4] = {
+		{12.5f, -7.25f, 1.0f, 1.0f},
+		{1919.0f, 1079.0f, 0.5f, 2.0f},
+		{-3000.125f, 4000.5f, 3.333f, 0.125f},
+	};
+
+	ZoominatorItemBatch wide;
+	for (int rep = 0; rep < 2; rep++)
+		for (const auto &v : values)
+			wide.push(v[0], v[1], v[2], v[3]);
+	wide.push(0.0f, 0.0f, 1.0f, 1.0f);
+	zoominator_camera_transform_items(camera, wide);
+
+	ZoominatorItemBatch tail;
+	for (const auto &v : values)
+		tail.push(v[0], v[1], v[2], v[3]);
+	zoominator_camera_transform_items(camera, tail);
+
+	for (size_t i = 0; i < 3; i++) {
+		CHECK(same_float(wide.outPosX[i], tail.outPosX[i]));
+		CHECK(same_float(wide.outPosY[i], tail.outPosY[i]));
+		CHECK(same_float(wide.outScaleX[i], tail.outScaleX[i]));
+		CHECK(same_float(wide.outScaleY[i], tail.outScaleY[i]));
+	}
+}
+
+ZOOMINATOR_TEST(transform_kernel_applies_the_camera_mapping)
+{
+	const ZoominatorCamera camera = test_camera();
+	ZoominatorItemBatch batch;
+	for (int i = 0; i < 6; i++)
+		batch.push((float)camera.focusX, (float)camera.focusY, 1.0f, 1.0f);
+	zoominator_camera_transform_items(camera, batch);
+
+	// An item whose top-left sits at the focus lands on anchor + offset.
+	for (size_t i = 0; i < batch.size(); i++) {
+		CHECK_NEAR(batch.outPosX[i], camera.anchorX + camera.offsetX, 1e-3);
+		CHECK_NEAR(batch.outPosY[i], camera.anchorY + camera.offsetY, 1e-3);
+		CHECK_NEAR(batch.outScaleX[i], camera.zoom, 1e-6);
+	}
+}
+
+// Row vector times matrix, as libobs' vec4_transform applies struct matrix4.
+static void apply_row_vector(const ZoominatorMatrix4 &m, float x, float y, float &outX, float &outY)
+{
+	const float p[4] = {x, y, 0.0f, 1.0f};
+	float out[4] = {};
+	for (int col = 0; col < 4; col++)
+		for (int row = 0; row < 4; row++)
+			out[col] += p[row] * m.rows[row][col];
+	outX = out[0] / out[3];
+	outY = out[1] / out[3];
+}
+
+ZOOMINATOR_TEST(filter_matrix_matches_item_mode)
+{
+	// The camera filter renders the whole scene through this matrix; item mode
+	// writes the kernel output to each item instead. Every point inside an
+	// item must land on the same canvas pixel either way.
+	const ZoominatorCamera camera = test_camera();
+	CHECK(camera.zoom != 1.0 && camera.translateX() != 0.0 && camera.translateY() != 0.0);
+	const ZoominatorMatrix4 m = zoominator_camera_filter_matrix(
+		(float)camera.zoom, (float)camera.translateX(), (float)camera.translateY());
+
+	ZoominatorItemBatch batch;
+	batch.push(0.0f, 0.0f, 1.0f, 1.0f);
+	batch.push(640.0f, 360.0f, 0.5f, 0.5f);
+	batch.push(-200.0f, 900.0f, 2.0f, 1.25f);
+	batch.push(1500.5f, 20.25f, 0.75f, 3.0f);
+	batch.push(960.0f, 540.0f, 1.0f, 1.0f);
+	zoominator_camera_transform_items(camera, batch);
+
+	for (size_t i = 0; i < batch.size(); i++) {
+		for (float u : {0.0f, 1.0f, 37.5f, 1280.0f}) {
+			const float sceneX = batch.posX[i] + u * batch.scaleX[i];
+			const float sceneY = batch.posY[i] + u * batch.scaleY[i];
+			float filterX = 0.0f;
+			float filterY = 0.0f;
+			apply_row_vector(m, sceneX, sceneY, filterX, filterY);
+			CHECK_NEAR(filterX, camera.mapX(sceneX), 1e-2);
+			CHECK_NEAR(filterY, camera.mapY(sceneY), 1e-2);
+			CHECK_NEAR(filterX, batch.outPosX[i] + u * batch.outScaleX[i], 1e-2);
+			CHECK_NEAR(filterY, batch.outPosY[i] + u * batch.outScaleY[i], 1e-2);
+		}
+	}
+
+	// At rest the filter is handed an identity transform and skips rendering.
+	ZoominatorCamera rest;
+	rest.anchorX = 960.0;
+	rest.anchorY = 540.0;
+	rest.focusX = 960.0;
+	rest.focusY = 540.0;
+	const ZoominatorMatrix4 identity =
+		zoominator_camera_filter_matrix((float)rest.zoom, (float)rest.translateX(), (float)rest.translateY());
+	for (int row = 0; row < 4; row++)
+		for (int col = 0; col < 4; col++)
+			CHECK(identity.rows[row][col] == (row == col ? 1.0f : 0.0f));
+}
+
+ZOOMINATOR_TEST_MAIN()
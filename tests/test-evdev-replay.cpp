@@ -0,0 +1,156 @@
+#include "zoominator-evdev.hpp"
+#include "zoominator-test.hpp"
+
+#include <X11/keysym.h>
+#include <linux/input.h>
+
+#include <initializer_list>
+#include <vector>
+
+using Event = ZoominatorEvdevInput::Event;
+using EventType = ZoominatorEvdevInput::EventType;
+
+static input_event rec(uint16_t type, uint16_t code, int32_t value, long usec = 0)
+{
+	input_event ie{};
+	ie.input_event_sec = 12;
+	ie.input_event_usec = usec;
+	ie.type = type;
+	ie.code = code;
+	ie.value = value;
+	return ie;
+}
+
+static std::vector<Event> replay(std::initializer_list<input_event> stream)
+{
+	const std::vector<input_event> events(stream);
+	std::vector<Event> out;
+	ZoominatorEvdevInput::replay(
+		events.data(), events.size(),
+		[](const Event &ev, void *param) { static_cast<std::vector<Event> *>(param)->push_back(ev); }, &out);
+	return out;
+}
+
+ZOOMINATOR_TEST(keys_map_to_keysyms_and_skip_autorepeat)
+{
+	const auto out = replay({
+		rec(EV_KEY, KEY_LEFTCTRL, 1, 100),
+		rec(EV_SYN, SYN_REPORT, 0, 100),
+		rec(EV_KEY, KEY_A, 1, 200),
+		rec(EV_SYN, SYN_REPORT, 0, 200),
+		rec(EV_KEY, KEY_A, 2, 300),
+		rec(EV_KEY, KEY_A, 2, 330),
+		rec(EV_SYN, SYN_REPORT, 0, 330),
+		rec(EV_KEY, KEY_A, 0, 400),
+		rec(EV_KEY, KEY_LEFTCTRL, 0, 410),
+		rec(EV_SYN, SYN_REPORT, 0, 410),
+	});
+
+	CHECK(out.size() == 4);
+	if (out.size() != 4)
+		return;
+	CHECK(out[0].type == EventType::Key && out[0].code == XK_Control_L && out[0].down);
+	CHECK(out[1].type == EventType::Key && out[1].code == XK_a && out[1].down);
+	CHECK(out[2].type == EventType::Key && out[2].code == XK_a && !out[2].down);
+	CHECK(out[3].type == EventType::Key && out[3].code == XK_Control_L && !out[3].down);
+	CHECK(out[1].tNs == 12000000000ull + 200000ull);
+	CHECK(!out[0].held);
+}
+
+ZOOMINATOR_TEST(keymap_covers_trigger_keys)
+{
+	CHECK(ZoominatorEvdevInput::keysymForCode(KEY_F13) == XK_F13);
+	CHECK(ZoominatorEvdevInput::keysymForCode(KEY_RIGHTMETA) == XK_Super_R);
+	CHECK(ZoominatorEvdevInput::keysymForCode(KEY_SPACE) == XK_space);
+	CHECK(ZoominatorEvdevInput::keysymForCode(-1) == 0);
+	CHECK(ZoominatorEvdevInput::keysymForCode(KEY_MAX) == 0);
+
+	// Codes without a mapping produce nothing.
+	CHECK(replay({rec(EV_KEY, KEY_MUTE, 1), rec(EV_SYN, SYN_REPORT, 0)}).empty());
+}
+
+ZOOMINATOR_TEST(relative_motion_is_summed_until_syn_report)
+{
+	const auto out = replay({
+		rec(EV_REL, REL_X, 3),
+		rec(EV_REL, REL_Y, -2),
+		rec(EV_REL, REL_X, 4),
+		rec(EV_SYN, SYN_REPORT, 0, 50),
+		rec(EV_SYN, SYN_REPORT, 0, 60),
+		rec(EV_REL, REL_WHEEL, 1),
+		rec(EV_SYN, SYN_REPORT, 0, 70),
+		rec(EV_REL, REL_Y, 5),
+		rec(EV_SYN, SYN_REPORT, 0, 80),
+	});
+
+	// Empty reports and wheel-only frames produce no motion.
+	CHECK(out.size() == 2);
+	if (out.size() != 2)
+		return;
+	CHECK(out[0].type == EventType::Motion && out[0].dx == 7 && out[0].dy == -2);
+	CHECK(out[0].tNs == 12000000000ull + 50000ull);
+	CHECK(out[1].type == EventType::Motion && out[1].dx == 0 && out[1].dy == 5);
+}
+
+ZOOMINATOR_TEST(syn_dropped_discards_the_partial_frame)
+{
+	const auto out = replay({
+		rec(EV_REL, REL_X, 40),
+		rec(EV_REL, REL_Y, 40),
+		rec(EV_SYN, SYN_DROPPED, 0),
+		rec(EV_SYN, SYN_REPORT, 0),
+		rec(EV_REL, REL_X, -1),
+		rec(EV_SYN, SYN_REPORT, 0),
+	});
+
+	CHECK(out.size() == 1);
+	if (out.size() == 1)
+		CHECK(out[0].type == EventType::Motion && out[0].dx == -1 && out[0].dy == 0);
+}
+
+ZOOMINATOR_TEST(buttons_map_to_x_button_numbers)
+{
+	const auto out = replay({
+		rec(EV_KEY, BTN_LEFT, 1),
+		rec(EV_KEY, BTN_MIDDLE, 1),
+		rec(EV_KEY, BTN_RIGHT, 1),
+		rec(EV_KEY, BTN_SIDE, 1),
+		rec(EV_KEY, BTN_EXTRA, 1),
+		rec(EV_KEY, BTN_BACK, 0),
+		rec(EV_KEY, BTN_FORWARD, 0),
+		rec(EV_SYN, SYN_REPORT, 0),
+	});
+
+	const int expected[] = {1, 2, 3, 8, 9, 8, 9};
+	CHECK(out.size() == 7);
+	for (size_t i = 0; i < out.size() && i < 7; i++) {
+		CHECK(out[i].type == EventType::Button);
+		CHECK(out[i].code == expected[i]);
+		CHECK(out[i].down == (i < 5));
+	}
+}
+
+ZOOMINATOR_TEST(absolute_only_pointers_are_not_tracked)
+{
+	// Documented limitation: touchpads that report only EV_ABS move no cursor,
+	// though their clicks still arrive.
+	const auto out = replay({
+		rec(EV_ABS, ABS_X, 1200),
+		rec(EV_ABS, ABS_Y, 800),
+		rec(EV_SYN, SYN_REPORT, 0),
+		rec(EV_KEY, BTN_LEFT, 1),
+		rec(EV_SYN, SYN_REPORT, 0),
+	});
+
+	CHECK(out.size() == 1);
+	if (out.size() == 1)
+		CHECK(out[0].type == EventType::Button && out[0].code == 1);
+}
+
+ZOOMINATOR_TEST(each_replay_starts_from_a_clean_device)
+{
+	CHECK(replay({rec(EV_REL, REL_X, 9)}).empty());
+	CHECK(replay({rec(EV_SYN, SYN_REPORT, 0)}).empty());
+}
+
+ZOOMINATOR_TEST_MAIN()
@@ -0,0 +1,117 @@
+#include "zoominator-recovery-index.hpp"
+#include "zoominator-test.hpp"
+
+static ZoominatorSceneItemKey make_key(uint8_t scene, uint8_t source, int64_t itemId)
+{
+	ZoominatorSceneItemKey key;
+	for (int i = 0; i < 16; i++) {
+		key.scene[i] = (uint8_t)(scene + i);
+		key.source[i] = (uint8_t)(source * 3 + i);
+	}
+	key.itemId = itemId;
+	return key;
+}
+
+ZOOMINATOR_TEST(exact_key_resolves_to_itself)
+{
+	ZoominatorRecoveryIndex index;
+	const ZoominatorSceneItemKey a = make_key(1, 1, 10);
+	const ZoominatorSceneItemKey b = make_key(1, 2, 11);
+	index.add(a);
+	index.add(b);
+
+	const ZoominatorSceneItemKey *hit = index.resolve(a);
+	CHECK(hit && *hit == a);
+	hit = index.resolve(b);
+	CHECK(hit && *hit == b);
+	CHECK(!index.resolve(make_key(2, 1, 10)));
+	CHECK(!index.resolve(make_key(1, 3, 10)));
+}
+
+ZOOMINATOR_TEST(lone_entry_matches_item_recreated_under_new_id)
+{
+	ZoominatorRecoveryIndex index;
+	const ZoominatorSceneItemKey saved = make_key(1, 1, 10);
+	index.add(saved);
+
+	const ZoominatorSceneItemKey *hit = index.resolve(make_key(1, 1, 99));
+	CHECK(hit && *hit == saved);
+	// Same source in another scene is a different item.
+	CHECK(!index.resolve(make_key(2, 1, 10)));
+}
+
+ZOOMINATOR_TEST(ambiguous_pair_only_matches_exact_ids)
+{
+	ZoominatorRecoveryIndex index;
+	const ZoominatorSceneItemKey first = make_key(1, 1, 10);
+	const ZoominatorSceneItemKey second = make_key(1, 1, 20);
+	index.add(first);
+	index.add(second);
+	// Re-adding a key must not make the pair look ambiguous or lone.
+	index.add(first);
+
+	CHECK(!index.resolve(make_key(1, 1, 30)));
+	const ZoominatorSceneItemKey *hit = index.resolve(second);
+	CHECK(hit && *hit == second);
+
+	ZoominatorRecoveryIndex lone;
+	lone.add(first);
+	lone.add(first);
+	hit = lone.resolve(make_key(1, 1, 30));
+	CHECK(hit && *hit == first);
+}
+
+ZOOMINATOR_TEST(legacy_keys_resolve_by_id_then_lone_entry)
+{
+	ZoominatorRecoveryIndex index;
+	index.addLegacy("Scene::Camera::4");
+	index.addLegacy("Scene::Slides::7");
+	index.addLegacy("Scene::Slides::8");
+	// Names may themselves contain the separator; only the last one splits off the id.
+	index.addLegacy("Main::Scene::Browser::12");
+
+	const std::string *hit = index.resolveLegacy("Scene::Camera", 4);
+	CHECK(hit && *hit == "Scene::Camera::4");
+	hit = index.resolveLegacy("Scene::Camera", 40);
+	CHECK(hit && *hit == "Scene::Camera::4");
+
+	hit = index.resolveLegacy("Scene::Slides", 8);
+	CHECK(hit && *hit == "Scene::Slides::8");
+	CHECK(!index.resolveLegacy("Scene::Slides", 9));
+
+	hit = index.resolveLegacy("Main::Scene::Browser", 1);
+	CHECK(hit && *hit == "Main::Scene::Browser::12");
+	CHECK(!index.resolveLegacy("Other::Camera", 4));
+}
+
+ZOOMINATOR_TEST(malformed_legacy_keys_are_ignored)
+{
+	ZoominatorRecoveryIndex index;
+	index.addLegacy("");
+	index.addLegacy("::5");
+	index.addLegacy("Scene::Camera");
+	index.addLegacy("Scene::Camera::");
+	index.addLegacy("Scene::Camera::4x");
+	index.addLegacy("Scene::Camera::99999999999999999999");
+
+	CHECK(!index.resolveLegacy("Scene", 5));
+	CHECK(!index.resolveLegacy("", 5));
+	CHECK(!index.resolveLegacy("Scene::Camera", 4));
+
+	index.addLegacy("Scene::Camera::-3");
+	const std::string *hit = index.resolveLegacy("Scene::Camera", -3);
+	CHECK(hit && *hit == "Scene::Camera::-3");
+}
+
+ZOOMINATOR_TEST(clear_drops_both_indexes)
+{
+	ZoominatorRecoveryIndex index;
+	index.add(make_key(1, 1, 10));
+	index.addLegacy("Scene::Camera::4");
+	index.clear();
+
+	CHECK(!index.resolve(make_key(1, 1, 10)));
+	CHECK(!index.resolveLegacy("Scene::Camera", 4));
+}
+
+ZOOMINATOR_TEST_MAIN()
@@ -0,0 +1,198 @@
+#include "zoominator-recovery-journal.hpp"
+#include "zoominator-test.hpp"
+
+#include <cstring>
+
+// Independent copies of the documented framing, so the tests pin the format
+// rather than whatever the codec happens to write.
+static uint32_t fnv1a(const std::string &data)
+{
+	uint32_t h = 2166136261u;
+	for (unsigned char c : data) {
+		h ^= c;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void put_u32(std::string &out, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		out.push_back((char)(uint8_t)(v >> (i * 8)));
+}
+
+static ZoominatorJournalRecord uuid_record(uint64_t activation, uint8_t seed)
+{
+	ZoominatorJournalRecord r;
+	r.activation = activation;
+	for (int i = 0; i < 16; i++) {
+		r.sceneUuid[i] = (uint8_t)(seed + i);
+		r.sourceUuid[i] = (uint8_t)(0xf0 - seed - i);
+	}
+	r.itemId = -(int64_t)seed * 1000 - 7;
+	r.posX = 12.5f;
+	r.posY = -3.25f;
+	r.scaleX = 2.0f;
+	r.scaleY = 0.5f;
+	r.rot = 90.0f;
+	r.align = 5;
+	r.boundsType = 2;
+	r.boundsAlign = 10;
+	r.boundsX = 1920.0f;
+	r.boundsY = 1080.0f;
+	r.cropLeft = 1;
+	r.cropTop = -2;
+	r.cropRight = 3;
+	r.cropBottom = 4;
+	r.hiddenByZoom = seed % 2 == 1;
+	return r;
+}
+
+static ZoominatorJournalRecord legacy_record(uint64_t activation, const char *key)
+{
+	ZoominatorJournalRecord r = uuid_record(activation, 3);
+	memset(r.sceneUuid, 0, sizeof(r.sceneUuid));
+	memset(r.sourceUuid, 0, sizeof(r.sourceUuid));
+	r.itemId = 0;
+	r.legacyKey = key;
+	return r;
+}
+
+static bool same_record(const ZoominatorJournalRecord &a, const ZoominatorJournalRecord &b)
+{
+	return a.activation == b.activation && memcmp(a.sceneUuid, b.sceneUuid, 16) == 0 &&
+	       memcmp(a.sourceUuid, b.sourceUuid, 16) == 0 && a.itemId == b.itemId && a.legacyKey == b.legacyKey &&
+	       a.posX == b.posX && a.posY == b.posY && a.scaleX == b.scaleX && a.scaleY == b.scaleY &&
+	       a.rot == b.rot && a.align == b.align && a.boundsType == b.boundsType &&
+	       a.boundsAlign == b.boundsAlign && a.boundsX == b.boundsX && a.boundsY == b.boundsY &&
+	       a.cropLeft == b.cropLeft && a.cropTop == b.cropTop && a.cropRight == b.cropRight &&
+	       a.cropBottom == b.cropBottom && a.hiddenByZoom == b.hiddenByZoom;
+}
+
+ZOOMINATOR_TEST(round_trips_uuid_and_legacy_keys)
+{
+	const ZoominatorJournalRecord written[] = {
+		uuid_record(1, 1),
+		legacy_record(1, "Scene::Camera::42"),
+		uuid_record(0xfedcba9876543210ull, 2),
+	};
+
+	std::string bytes = zoominator_journal_header();
+	for (const auto &r : written)
+		zoominator_journal_encode(bytes, r);
+
+	std::vector<ZoominatorJournalRecord> read;
+	CHECK(zoominator_journal_decode(bytes, read));
+	CHECK(read.size() == 3);
+	for (size_t i = 0; i < read.size() && i < 3; i++)
+		CHECK(same_record(read[i], written[i]));
+}
+
+ZOOMINATOR_TEST(header_only_and_foreign_files)
+{
+	std::vector<ZoominatorJournalRecord> read;
+	CHECK(zoominator_journal_decode(zoominator_journal_header(), read));
+	CHECK(read.empty());
+
+	CHECK(!zoominator_journal_decode("", read));
+	CHECK(!zoominator_journal_decode("{\"recovery\":{}}", read));
+
+	std::string future("ZMRJ", 4);
+	put_u32(future, 99);
+	CHECK(!zoominator_journal_decode(future, read));
+}
+
+ZOOMINATOR_TEST(torn_trailing_record_keeps_earlier_records)
+{
+	std::string bytes = zoominator_journal_header();
+	zoominator_journal_encode(bytes, uuid_record(1, 1));
+	zoominator_journal_encode(bytes, legacy_record(1, "Scene::Text::7"));
+	const size_t intact = bytes.size();
+	zoominator_journal_encode(bytes, uuid_record(2, 4));
+
+	// Every cut inside the last record, including inside its length prefix.
+	for (size_t cut = intact + 1; cut < bytes.size(); cut++) {
+		std::vector<ZoominatorJournalRecord> read;
+		CHECK(zoominator_journal_decode(bytes.substr(0, cut), read));
+		CHECK(read.size() == 2);
+		if (read.size() == 2)
+			CHECK(read[1].legacyKey == "Scene::Text::7");
+	}
+}
+
+ZOOMINATOR_TEST(bad_checksum_stops_replay)
+{
+	std::string bytes = zoominator_journal_header();
+	zoominator_journal_encode(bytes, uuid_record(1, 1));
+	const size_t second = bytes.size();
+	zoominator_journal_encode(bytes, uuid_record(1, 2));
+	zoominator_journal_encode(bytes, uuid_record(1, 3));
+
+	// Flip one payload byte of the middle record; replay keeps only the first,
+	// even though the record after it is intact.
+	bytes[second + 8 + 20] ^= 0x40;
+	std::vector<ZoominatorJournalRecord> read;
+	CHECK(zoominator_journal_decode(bytes, read));
+	CHECK(read.size() == 1);
+	if (read.size() == 1)
+		CHECK(same_record(read[0], uuid_record(1, 1)));
+
+	// An absurd length prefix is treated the same way.
+	std::string huge = zoominator_journal_header();
+	zoominator_journal_encode(huge, uuid_record(1, 1));
+	put_u32(huge, 0x7fffffff);
+	put_u32(huge, 0);
+	huge.append(64, 'x');
+	CHECK(zoominator_journal_decode(huge, read));
+	CHECK(read.size() == 1);
+}
+
+// Version 1 payloads had no key-kind byte: u64 activation, u16 length, key,
+// then the same transform fields.
+static std::string v1_journal(const std::vector<ZoominatorJournalRecord> &records)
+{
+	std::string out("ZMRJ", 4);
+	put_u32(out, 1);
+	for (const auto &r : records) {
+		std::string v2;
+		zoominator_journal_encode(v2, r);
+		std::string payload = v2.substr(8);
+		payload.erase(8, 1);
+		put_u32(out, (uint32_t)payload.size());
+		put_u32(out, fnv1a(payload));
+		out += payload;
+	}
+	return out;
+}
+
+ZOOMINATOR_TEST(reads_version_1_journals)
+{
+	const std::vector<ZoominatorJournalRecord> written = {
+		legacy_record(3, "Main::Browser::12"),
+		legacy_record(4, "Nested Scene::Image::3"),
+	};
+
+	std::vector<ZoominatorJournalRecord> read;
+	CHECK(zoominator_journal_decode(v1_journal(written), read));
+	CHECK(read.size() == 2);
+	for (size_t i = 0; i < read.size() && i < 2; i++)
+		CHECK(same_record(read[i], written[i]));
+
+	// A version 1 record with an empty key is corrupt and ends replay.
+	std::string v2;
+	zoominator_journal_encode(v2, legacy_record(3, "x"));
+	std::string blank = v2.substr(8);
+	blank.erase(8, 1);
+	blank[8] = 0;
+	blank[9] = 0;
+	blank.erase(10, 1);
+
+	std::string bytes = v1_journal({written[0]});
+	put_u32(bytes, (uint32_t)blank.size());
+	put_u32(bytes, fnv1a(blank));
+	bytes += blank;
+	CHECK(zoominator_journal_decode(bytes, read));
+	CHECK(read.size() == 1);
+}
+
+ZOOMINATOR_TEST_MAIN()
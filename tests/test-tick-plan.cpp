@@ -0,0 +1,130 @@
+#include "zoominator-test.hpp"
+#include "zoominator-tick-plan.hpp"
+
+ZOOMINATOR_TEST(screen_map_scales_and_clamps)
+{
+	const ZoominatorScreenMap m = ZoominatorScreenMap::fromRect(1920, 0, 2560, 1440, 1920.0, 1080.0);
+	CHECK(m.valid);
+
+	float sx = 0.0f, sy = 0.0f;
+	bool inside = false;
+	CHECK(m.map(1920, 0, sx, sy, inside));
+	CHECK(inside);
+	CHECK(sx == 0.0f && sy == 0.0f);
+
+	CHECK(m.map(1920 + 1280, 720, sx, sy, inside));
+	CHECK(sx == 960.0f && sy == 540.0f);
+
+	// Off the selected screen the point is clamped to its last pixel.
+	CHECK(m.map(100, 5000, sx, sy, inside));
+	CHECK(!inside);
+	CHECK(sx == 0.0f);
+	CHECK_NEAR(sy, 1439.0 * 0.75, 1e-3);
+
+	CHECK(!ZoominatorScreenMap::fromRect(0, 0, 0, 1080, 1920.0, 1080.0).valid);
+	CHECK(!ZoominatorScreenMap{}.map(0, 0, sx, sy, inside));
+}
+
+static ZoominatorCamera camera_at(double zoom, double focusX)
+{
+	ZoominatorCamera camera;
+	camera.zoom = zoom;
+	camera.anchorX = 960.0;
+	camera.anchorY = 540.0;
+	camera.focusX = focusX;
+	camera.focusY = 540.0;
+	return camera;
+}
+
+ZOOMINATOR_TEST(first_plan_writes_and_normalizes_every_item)
+{
+	int a = 0, b = 0;
+	ZoominatorTickPlanner planner;
+	planner.add(&a, 0.0f, 0.0f, 1.0f, 1.0f);
+	planner.add(&b, 100.0f, 50.0f, 0.5f, 2.0f);
+	CHECK(planner.size() == 2);
+	CHECK(planner.item(1) == &b);
+
+	const ZoominatorCamera camera = camera_at(2.0, 960.0);
+	planner.plan(camera);
+	CHECK(planner.ops().size() == 2);
+	CHECK(planner.applied() == 2);
+	CHECK(planner.skipped() == 0);
+	for (const ZoominatorPlanOp &op : planner.ops()) {
+		CHECK(op.normalize);
+		CHECK(op.setPos && op.setScale);
+	}
+	const ZoominatorPlanOp &op = planner.ops()[1];
+	CHECK(op.index == 1);
+	CHECK_NEAR(op.posX, camera.mapX(100.0), 1e-3);
+	CHECK_NEAR(op.posY, camera.mapY(50.0), 1e-3);
+	CHECK_NEAR(op.scaleX, 1.0, 1e-6);
+	CHECK_NEAR(op.scaleY, 4.0, 1e-6);
+}
+
+ZOOMINATOR_TEST(unchanged_items_are_skipped)
+{
+	int a = 0;
+	ZoominatorTickPlanner planner;
+	planner.add(&a, 10.0f, 10.0f, 1.0f, 1.0f);
+	planner.plan(camera_at(2.0, 960.0));
+
+	planner.plan(camera_at(2.0, 960.0));
+	CHECK(planner.ops().empty());
+	CHECK(planner.applied() == 0);
+	CHECK(planner.skipped() == 1);
+
+	// A sub-epsilon pan is still skipped; a real one writes position only.
+	planner.plan(camera_at(2.0, 960.002));
+	CHECK(planner.ops().empty());
+	planner.plan(camera_at(2.0, 970.0));
+	CHECK(planner.ops().size() == 1);
+	CHECK(planner.ops()[0].setPos);
+	CHECK(!planner.ops()[0].setScale);
+	CHECK(!planner.ops()[0].normalize);
+
+	// Zooming changes both.
+	planner.plan(camera_at(2.5, 970.0));
+	CHECK(planner.ops().size() == 1);
+	CHECK(planner.ops()[0].setPos && planner.ops()[0].setScale);
+}
+
+ZOOMINATOR_TEST(items_gone_from_the_scene_are_not_planned)
+{
+	int a = 0, b = 0;
+	ZoominatorTickPlanner planner;
+	planner.add(&a, 0.0f, 0.0f, 1.0f, 1.0f);
+	planner.add(&b, 0.0f, 0.0f, 1.0f, 1.0f);
+	planner.setLive(0, false);
+	planner.plan(camera_at(2.0, 960.0));
+	CHECK(planner.ops().size() == 1);
+	CHECK(planner.ops()[0].index == 1);
+	CHECK(planner.applied() == 1);
+	CHECK(planner.skipped() == 0);
+
+	// Back in the scene, it is written and normalized on its first plan.
+	planner.setLive(0, true);
+	planner.plan(camera_at(2.0, 960.0));
+	CHECK(planner.ops().size() == 1);
+	CHECK(planner.ops()[0].index == 0);
+	CHECK(planner.ops()[0].normalize);
+
+	planner.clear();
+	CHECK(planner.size() == 0);
+	planner.plan(camera_at(2.0, 960.0));
+	CHECK(planner.ops().empty());
+}
+
+ZOOMINATOR_TEST(marker_point_follows_the_camera_unless_in_scene_space)
+{
+	const ZoominatorCamera camera = camera_at(2.0, 500.0);
+	double x = 0.0, y = 0.0;
+	ZoominatorTickPlanner::markerPoint(camera, false, 510.0f, 530.0f, x, y);
+	CHECK(x == 980.0);
+	CHECK(y == 520.0);
+	ZoominatorTickPlanner::markerPoint(camera, true, 510.0f, 530.0f, x, y);
+	CHECK(x == 510.0);
+	CHECK(y == 530.0);
+}
+
+ZOOMINATOR_TEST_MAIN()
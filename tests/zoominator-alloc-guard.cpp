@@ -0,0 +1,152 @@
+#include "zoominator-alloc-guard.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new/delete of whichever test executable links
+// this file. Never link it into the plugin: in a module it would interpose on
+// every allocation in the OBS process.
+
+static thread_local uint64_t g_threadAllocations = 0;
+
+uint64_t zoominator_thread_allocations()
+{
+	return g_threadAllocations;
+}
+
+static void *counted_alloc(std::size_t size)
+{
+	g_threadAllocations++;
+	return std::malloc(size ? size : 1);
+}
+
+static void *counted_alloc_aligned(std::size_t size, std::align_val_t align)
+{
+	g_threadAllocations++;
+	const std::size_t alignment = (std::size_t)align;
+#ifdef _WIN32
+	return _aligned_malloc(size ? size : 1, alignment);
+#else
+	void *p = nullptr;
+	return posix_memalign(&p, alignment < sizeof(void *) ? sizeof(void *) : alignment, size ? size : 1) == 0
+		       ? p
+		       : nullptr;
+#endif
+}
+
+static void counted_free_aligned(void *p) noexcept
+{
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void *operator new(std::size_t size)
+{
+	if (void *p = counted_alloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+	if (void *p = counted_alloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	return counted_alloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+	return counted_alloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align)
+{
+	if (void *p = counted_alloc_aligned(size, align))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t align)
+{
+	if (void *p = counted_alloc_aligned(size, align))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	return counted_alloc_aligned(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	return counted_alloc_aligned(size, align);
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+	counted_free_aligned(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+	counted_free_aligned(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+	counted_free_aligned(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+	counted_free_aligned(p);
+}
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	counted_free_aligned(p);
+}
+
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	counted_free_aligned(p);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Per-thread heap allocation count, for tests that assert a code path stays
+// off the heap. Linking zoominator-alloc-guard.cpp replaces the global
+// operator new with the counting one.
+uint64_t zoominator_thread_allocations();
+
+class ZoominatorAllocScope final {
+public:
+	ZoominatorAllocScope() : start(zoominator_thread_allocations()) {}
+
+	uint64_t count() const { return zoominator_thread_allocations() - start; }
+
+private:
+	uint64_t start;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+// Minimal self-registering test harness so the standalone units can be
+// checked without pulling a framework into the plugin build. Each executable
+// lists its cases with ZOOMINATOR_TEST and ends with ZOOMINATOR_TEST_MAIN().
+
+namespace zoominator_test {
+
+struct Case {
+	const char *name;
+	std::function<void()> fn;
+};
+
+inline std::vector<Case> &cases()
+{
+	static std::vector<Case> list;
+	return list;
+}
+
+inline int &failures()
+{
+	static int count = 0;
+	return count;
+}
+
+struct Registrar {
+	Registrar(const char *name, std::function<void()> fn) { cases().push_back({name, std::move(fn)}); }
+};
+
+inline void fail(const char *file, int line, const char *expr)
+{
+	std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+	failures()++;
+}
+
+inline int run_all()
+{
+	for (const Case &c : cases()) {
+		const int before = failures();
+		c.fn();
+		std::printf("[%s] %s\n", failures() == before ? " ok " : "FAIL", c.name);
+	}
+	std::printf("%zu case(s), %d failed check(s)\n", cases().size(), failures());
+	return failures() == 0 ? 0 : 1;
+}
+
+} // namespace zoominator_test
+
+#define ZOOMINATOR_TEST_CAT2(a, b) a##b
+#define ZOOMINATOR_TEST_CAT(a, b) ZOOMINATOR_TEST_CAT2(a, b)
+
+#define ZOOMINATOR_TEST(name)                                                                        \
+	static void ZOOMINATOR_TEST_CAT(test_, name)();                                              \
+	static zoominator_test::Registrar ZOOMINATOR_TEST_CAT(registrar_, name)(                     \
+		#name, ZOOMINATOR_TEST_CAT(test_, name));                                            \
+	static void ZOOMINATOR_TEST_CAT(test_, name)()
+
+#define CHECK(expr)                                                    \
+	do {                                                           \
+		if (!(expr))                                           \
+			zoominator_test::fail(__FILE__, __LINE__, #expr); \
+	} while (0)
+
+#define CHECK_NEAR(a, b, eps) CHECK(std::fabs((double)(a) - (double)(b)) <= (double)(eps))
+
+#define ZOOMINATOR_TEST_MAIN()                       \
+	int main()                                   \
+	{                                            \
+		return zoominator_test::run_all();   \
+	}